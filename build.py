@@ -8,7 +8,7 @@ import subprocess
 
 def build_and_run(compiler, flags, source_files, program_name):
     print("Building", program_name)
-    command = [compiler, "-std=c++20"]
+    command = [compiler, "-std=c++20", "-pthread"]
     command.extend(flags)
     command.extend(source_files)
     command.extend(["-o", program_name])
@@ -18,21 +18,25 @@ def build_and_run(compiler, flags, source_files, program_name):
 
 
 PERFT_SOURCE_FILES = [
+    "src/Bitboard.cpp",
     "src/ChessPiece.cpp",
     "src/ChessMove.cpp",
     "src/ChessBoard.cpp",
     "src/CastlingRights.cpp",
     "src/ChessPosition.cpp",
+    "src/Perft.cpp",
     "perft.cpp",
 ]
 
 BENCHMARK_SOURCE_FILES = [
+    "src/Bitboard.cpp",
     "src/ChessPiece.cpp",
     "src/ChessMove.cpp",
     "src/ChessBoard.cpp",
     "src/CastlingRights.cpp",
     "src/ChessPosition.cpp",
     "src/ChessEngine.cpp",
+    "src/PositionInfoCache.cpp",
     "src/ChessGame.cpp",
     "src/Utilities.cpp",
     "src/Engine/Random.cpp",
@@ -68,6 +72,15 @@ FLAGS = [
     ("-DSUCKER_CHESS_USE_COMPRESSED_CHESS_MOVE", 'M'),
     ("-DSUCKER_CHESS_USE_COMPRESSED_CHESS_BOARD", 'B'),
     ("-DSUCKER_CHESS_TRACK_KING_LOCATIONS", 'K'),
+    ("-DSUCKER_CHESS_TRACK_PIECE_COUNTS", 'C'),
+    ("-DSUCKER_CHESS_USE_BITBOARDS", 'X'),
+    ("-DSUCKER_CHESS_USE_ZOBRIST_HASH", 'Z'),
+    ("-DSUCKER_CHESS_TRACK_MATERIAL_SCORE", 'S'),
+]
+
+# pairs of flags that cannot be enabled at the same time
+INCOMPATIBLE_FLAGS = [
+    ('B', 'X'),
 ]
 
 
@@ -81,6 +94,11 @@ def main():
         for i in range(len(FLAGS)):
             for selected in itertools.combinations(FLAGS, i):
 
+                suffixes = {suffix for flag, suffix in selected}
+                if any(a in suffixes and b in suffixes
+                       for a, b in INCOMPATIBLE_FLAGS):
+                    continue
+
                 variant_name = compiler_name + "".join(
                     suffix for flag, suffix in selected
                 )
@@ -3,6 +3,7 @@
 #include <iostream>
 #include <memory>
 #include <string>
+#include <thread>
 
 #include "src/ChessGame.hpp"
 #include "src/GenePool.hpp"
@@ -20,7 +21,7 @@ int main() {
         std::cout << "Round " << round_count++ << '\n';
 
         // Let each engine play every other engine as black and white 2 times
-        evo_tourney.evaluate_fitness(2);
+        evo_tourney.evaluate_fitness(2, std::thread::hardware_concurrency());
         evo_tourney.sort_by_fitness();
 
         // Output round results
@@ -1,24 +1,16 @@
-#include <chrono>   // for std::chrono
-#include <cstdlib>  // for EXIT_SUCCESS, EXIT_FAILURE
-#include <iostream> // for std::cout, std::cerr, std::endl
-#include <string>   // for std::string
+#include <charconv>     // for std::from_chars
+#include <chrono>       // for std::chrono
+#include <cstddef>      // for std::size_t
+#include <cstdlib>      // for EXIT_SUCCESS, EXIT_FAILURE
+#include <iostream>     // for std::cout, std::cerr, std::endl
+#include <stdexcept>    // for std::invalid_argument
+#include <string>       // for std::string
+#include <system_error> // for std::errc
+#include <thread>       // for std::thread
 
 #include "src/ChessMove.hpp"
 #include "src/ChessPosition.hpp"
-
-
-static constexpr unsigned long long
-perft(const ChessPosition &pos, int depth) noexcept {
-    if (depth <= 0) {
-        return 1;
-    } else {
-        unsigned long long result = 0;
-        pos.visit_legal_moves([&](ChessMove, const ChessPosition &next) {
-            result += perft(next, depth - 1);
-        });
-        return result;
-    }
-}
+#include "src/Perft.hpp"
 
 
 static bool perft_test(
@@ -38,7 +30,70 @@ static bool perft_test(
 }
 
 
-int main() {
+static double seconds_since(std::chrono::high_resolution_clock::time_point t
+) noexcept {
+    const auto delta = std::chrono::high_resolution_clock::now() - t;
+    return static_cast<double>(
+               std::chrono::duration_cast<std::chrono::nanoseconds>(delta)
+                   .count()
+           ) /
+           1'000'000'000.0;
+}
+
+
+// Parses a positive perft depth. Returns false if str is not one.
+static bool parse_depth(const std::string &str, int &depth) noexcept {
+    const char *const begin = str.data();
+    const char *const end = begin + str.size();
+    const auto [ptr, ec] = std::from_chars(begin, end, depth);
+    return (ec == std::errc()) && (ptr == end) && (depth > 0);
+}
+
+
+static int print_usage(const char *program) {
+    std::cerr << "Usage: " << program << " <depth> [\"<fen>\"]" << std::endl;
+    return EXIT_FAILURE;
+}
+
+
+// Usage: SuckerChessPerft <depth> ["<fen>"]
+// Prints the perft count below each root move of the given position (or the
+// initial position), computed in parallel with a shared perft table.
+static int run_divide(const char *program, int depth, const std::string &fen) {
+    constexpr std::size_t TABLE_BYTES = 256 * 1024 * 1024;
+    ChessPosition pos;
+    try {
+        pos = ChessPosition(fen);
+    } catch (const std::invalid_argument &e) {
+        std::cerr << "ERROR: Invalid FEN: " << e.what() << std::endl;
+        return print_usage(program);
+    }
+    const auto begin = std::chrono::high_resolution_clock::now();
+    PerftTable table(TABLE_BYTES);
+    print_perft_divide(
+        std::cout,
+        perft_divide(pos, depth, std::thread::hardware_concurrency(), table)
+    );
+    std::cout << "Completed in " << seconds_since(begin) << " seconds."
+              << std::endl;
+    return EXIT_SUCCESS;
+}
+
+
+int main(int argc, char **argv) {
+
+    if (argc > 1) {
+        int depth = 0;
+        if ((argc > 3) || !parse_depth(argv[1], depth)) {
+            return print_usage(argv[0]);
+        }
+        return run_divide(
+            argv[0],
+            depth,
+            (argc > 2) ? argv[2]
+                       : "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq -"
+        );
+    }
 
     // Reference perft data from:
     // https://www.chessprogramming.org/Perft_Results
@@ -114,16 +169,8 @@ int main() {
     // clang-format on
 
     if (all_tests_passed) {
-        const auto end = std::chrono::high_resolution_clock::now();
-        const auto delta = end - begin;
-        const double duration =
-            static_cast<double>(
-                std::chrono::duration_cast<std::chrono::nanoseconds>(delta)
-                    .count()
-            ) /
-            1'000'000'000.0;
-        std::cout << "All tests passed in " << duration << " seconds."
-                  << std::endl;
+        std::cout << "All tests passed in " << seconds_since(begin)
+                  << " seconds." << std::endl;
         return EXIT_SUCCESS;
     } else {
         return EXIT_FAILURE;
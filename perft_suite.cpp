@@ -0,0 +1,263 @@
+#include <charconv>     // for std::from_chars
+#include <chrono>       // for std::chrono
+#include <cstdlib>      // for EXIT_SUCCESS, EXIT_FAILURE
+#include <fstream>      // for std::ifstream, std::ofstream
+#include <iomanip>      // for std::setw
+#include <iostream>     // for std::cout, std::cerr, std::endl
+#include <sstream>      // for std::istringstream
+#include <stdexcept>    // for std::invalid_argument
+#include <string>       // for std::string, std::getline
+#include <system_error> // for std::errc
+#include <vector>       // for std::vector
+
+#include "src/ChessPosition.hpp"
+#include "src/Perft.hpp"
+#include "src/Utilities.hpp"
+
+
+struct PerftSuiteResult {
+
+    std::size_t line_number;
+    std::string fen;
+    int depth;
+    unsigned long long expected;
+    unsigned long long actual;
+    double seconds;
+
+}; // struct PerftSuiteResult
+
+
+static double seconds_since(std::chrono::high_resolution_clock::time_point t
+) noexcept {
+    const auto delta = std::chrono::high_resolution_clock::now() - t;
+    return static_cast<double>(
+               std::chrono::duration_cast<std::chrono::nanoseconds>(delta)
+                   .count()
+           ) /
+           1'000'000'000.0;
+}
+
+
+static double nodes_per_second(unsigned long long nodes, double seconds) {
+    return (seconds > 0.0) ? static_cast<double>(nodes) / seconds : 0.0;
+}
+
+
+static std::string json_escape(const std::string &str) {
+    std::string result;
+    for (char ch : str) {
+        if ((ch == '"') || (ch == '\\')) { result.push_back('\\'); }
+        result.push_back(ch);
+    }
+    return result;
+}
+
+
+// Runs every "Dn count" operation of one EPD line with min_depth <= n <=
+// max_depth, e.g., for the line
+//     rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - ;D1 20 ;D2 400
+static void run_epd_line(
+    const std::string &line,
+    std::size_t line_number,
+    int min_depth,
+    int max_depth,
+    std::vector<PerftSuiteResult> &results,
+    std::ostream &report
+) {
+    std::istringstream fields(line);
+    std::string fen;
+    std::getline(fields, fen, ';');
+    trim(fen);
+    if (fen.empty()) { return; }
+    const ChessPosition pos(fen);
+
+    std::string operation;
+    while (std::getline(fields, operation, ';')) {
+        trim(operation);
+        if (operation.empty()) { continue; }
+        if (operation[0] != 'D') {
+            throw std::invalid_argument(
+                "EPD operation is not a perft depth: " + operation
+            );
+        }
+        std::istringstream operands(operation.substr(1));
+        int depth;
+        unsigned long long expected;
+        if (!(operands >> depth >> expected)) {
+            throw std::invalid_argument(
+                "EPD perft operation is malformed: " + operation
+            );
+        }
+        if ((depth < min_depth) || (depth > max_depth)) { continue; }
+        const auto begin = std::chrono::high_resolution_clock::now();
+        const unsigned long long actual = perft(pos, depth);
+        const double seconds = seconds_since(begin);
+        results.push_back({line_number, fen, depth, expected, actual, seconds}
+        );
+        const PerftSuiteResult &result = results.back();
+        report << (actual == expected ? "PASS" : "FAIL") << "  line "
+               << std::setw(4) << line_number << "  D" << depth
+               << std::setw(14) << actual << " nodes  " << std::setw(12)
+               << static_cast<unsigned long long>(
+                      nodes_per_second(result.actual, result.seconds)
+                  )
+               << " nps  " << fen << std::endl;
+        if (actual != expected) {
+            std::cerr << "ERROR: Computed " << actual << ", expected "
+                      << expected << std::endl;
+        }
+    }
+}
+
+
+static void write_json(
+    std::ostream &os,
+    const std::vector<PerftSuiteResult> &results,
+    unsigned long long total_nodes,
+    double total_seconds,
+    bool all_tests_passed
+) {
+    os << "{\n  \"results\": [";
+    bool first = true;
+    for (const PerftSuiteResult &result : results) {
+        os << (first ? "\n" : ",\n");
+        first = false;
+        os << "    {\"line\": " << result.line_number << ", \"fen\": \""
+           << json_escape(result.fen) << "\", \"depth\": " << result.depth
+           << ", \"expected\": " << result.expected
+           << ", \"nodes\": " << result.actual << ", \"seconds\": "
+           << result.seconds << ", \"nps\": "
+           << nodes_per_second(result.actual, result.seconds)
+           << ", \"passed\": "
+           << (result.actual == result.expected ? "true" : "false") << "}";
+    }
+    os << "\n  ],\n";
+    os << "  \"total_nodes\": " << total_nodes << ",\n";
+    os << "  \"total_seconds\": " << total_seconds << ",\n";
+    os << "  \"total_nps\": " << nodes_per_second(total_nodes, total_seconds)
+       << ",\n";
+    os << "  \"passed\": " << (all_tests_passed ? "true" : "false") << "\n";
+    os << "}\n";
+}
+
+
+// Parses a non-negative perft depth. Returns false if str is not one.
+static bool parse_depth(const std::string &str, int &depth) noexcept {
+    const char *const begin = str.data();
+    const char *const end = begin + str.size();
+    const auto [ptr, ec] = std::from_chars(begin, end, depth);
+    return (ec == std::errc()) && (ptr == end) && (depth >= 0);
+}
+
+
+static int print_usage(const char *program) {
+    std::cerr << "Usage: " << program
+              << " <epd-file> [<max-depth> [<min-depth>]]"
+                 " [--json <json-file>]"
+              << std::endl;
+    return EXIT_FAILURE;
+}
+
+
+// Usage: SuckerChessPerftSuite <epd-file> [<max-depth> [<min-depth>]]
+//                              [--json <json-file>]
+// Runs the perft counts listed in an EPD file (by default, every depth up to
+// 6) and reports nodes per second for each count and for the whole suite.
+// With --json, the same results are also written to json-file ("-" for
+// standard output, in which case the human-readable report goes to standard
+// error instead).
+int main(int argc, char **argv) {
+
+    std::vector<std::string> args;
+    std::string json_path;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--json") {
+            if (i + 1 >= argc) { return print_usage(argv[0]); }
+            json_path = argv[++i];
+        } else {
+            args.push_back(arg);
+        }
+    }
+    if (args.empty() || (args.size() > 3)) { return print_usage(argv[0]); }
+    int max_depth = 6;
+    int min_depth = 0;
+    if (((args.size() > 1) && !parse_depth(args[1], max_depth)) ||
+        ((args.size() > 2) && !parse_depth(args[2], min_depth)) ||
+        (min_depth > max_depth)) {
+        return print_usage(argv[0]);
+    }
+
+    std::ifstream epd_file(args[0]);
+    if (!epd_file) {
+        std::cerr << "ERROR: Could not open EPD file: " << args[0]
+                  << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // keep standard output machine-readable when JSON is written there
+    std::ostream &report = (json_path == "-") ? std::cerr : std::cout;
+
+    // build the slider attack tables before anything is timed
+    static_cast<void>(perft(ChessPosition(), 1));
+
+    std::vector<PerftSuiteResult> results;
+    std::string line;
+    std::size_t line_number = 0;
+    try {
+        while (std::getline(epd_file, line)) {
+            ++line_number;
+            trim(line);
+            if (line.empty() || (line[0] == '#')) { continue; }
+            run_epd_line(
+                line, line_number, min_depth, max_depth, results, report
+            );
+        }
+    } catch (const std::invalid_argument &e) {
+        std::cerr << "ERROR: Line " << line_number << ": " << e.what()
+                  << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    if (results.empty()) {
+        std::cerr << "ERROR: No perft counts between depths " << min_depth
+                  << " and " << max_depth << " in EPD file: " << args[0]
+                  << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    bool all_tests_passed = true;
+    unsigned long long total_nodes = 0;
+    double total_seconds = 0.0;
+    for (const PerftSuiteResult &result : results) {
+        all_tests_passed &= (result.actual == result.expected);
+        total_nodes += result.actual;
+        total_seconds += result.seconds;
+    }
+    report << "\nRan " << results.size() << " perft counts (" << total_nodes
+           << " nodes) in " << total_seconds << " seconds at "
+           << static_cast<unsigned long long>(
+                  nodes_per_second(total_nodes, total_seconds)
+              )
+           << " nodes per second." << std::endl;
+    report << (all_tests_passed ? "All tests passed." : "Tests FAILED.")
+           << std::endl;
+
+    if (json_path == "-") {
+        write_json(
+            std::cout, results, total_nodes, total_seconds, all_tests_passed
+        );
+    } else if (!json_path.empty()) {
+        std::ofstream json_file(json_path);
+        if (!json_file) {
+            std::cerr << "ERROR: Could not open JSON file: " << json_path
+                      << std::endl;
+            return EXIT_FAILURE;
+        }
+        write_json(
+            json_file, results, total_nodes, total_seconds, all_tests_passed
+        );
+    }
+
+    return all_tests_passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,134 @@
+#include "Bitboard.hpp"
+
+
+namespace {
+
+
+// Squares whose occupancy can affect the attacks of a slider on the given
+// square. Edge squares are excluded because a ray always ends there anyway.
+template <typename F>
+[[nodiscard]] bitboard_t
+relevant_occupancy(ChessSquare square, const F &ray_attacks_fn) noexcept {
+    bitboard_t edges = 0;
+    for (coord_t i = 0; i < NUM_RANKS; ++i) {
+        if (square.file != 0) { edges |= square_bit({0, i}); }
+        if (square.file != NUM_FILES - 1) {
+            edges |= square_bit({NUM_FILES - 1, i});
+        }
+    }
+    for (coord_t i = 0; i < NUM_FILES; ++i) {
+        if (square.rank != 0) { edges |= square_bit({i, 0}); }
+        if (square.rank != NUM_RANKS - 1) {
+            edges |= square_bit({i, NUM_RANKS - 1});
+        }
+    }
+    return ray_attacks_fn(square, 0) & ~edges;
+}
+
+
+#ifndef __BMI2__
+
+// xorshift64* generator with a fixed seed, so that the magic number search
+// (and hence table layout) is identical on every run.
+class MagicRandom final {
+
+    std::uint64_t state;
+
+public:
+
+    explicit constexpr MagicRandom(std::uint64_t seed) noexcept
+        : state(seed) {}
+
+    std::uint64_t next() noexcept {
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        return state * 0x2545F4914F6CDD1DULL;
+    }
+
+    // magic numbers with few set bits are much more likely to work
+    std::uint64_t next_sparse() noexcept { return next() & next() & next(); }
+
+}; // class MagicRandom
+
+#endif // __BMI2__
+
+
+template <std::size_t N, typename F>
+void init_slider_table(
+    std::array<MagicEntry, NUM_SQUARES> &entries,
+    std::array<bitboard_t, N> &table,
+    const F &ray_attacks_fn
+) noexcept {
+
+    constexpr std::size_t MAX_SUBSETS = 4096;
+    std::array<bitboard_t, MAX_SUBSETS> occupancies;
+    std::array<bitboard_t, MAX_SUBSETS> references;
+#ifndef __BMI2__
+    std::array<unsigned, MAX_SUBSETS> epochs = {};
+    unsigned attempt = 0;
+    MagicRandom rng(0x5EED5EED5EED5EEDULL);
+#endif
+
+    bitboard_t *next_attacks = table.data();
+    for (std::size_t i = 0; i < NUM_SQUARES; ++i) {
+        const ChessSquare square = square_at_index(i);
+        MagicEntry &entry = entries[i];
+        entry.mask = relevant_occupancy(square, ray_attacks_fn);
+        entry.magic = 0;
+        entry.attacks = next_attacks;
+        entry.shift = static_cast<unsigned>(NUM_SQUARES) -
+                      static_cast<unsigned>(popcount(entry.mask));
+
+        // enumerate every subset of the mask (Carry-Rippler trick)
+        std::size_t size = 0;
+        bitboard_t subset = 0;
+        do {
+            occupancies[size] = subset;
+            references[size] = ray_attacks_fn(square, subset);
+            ++size;
+            subset = (subset - entry.mask) & entry.mask;
+        } while (subset != 0);
+        bitboard_t *const attacks = next_attacks;
+        next_attacks += size;
+
+#ifdef __BMI2__
+        for (std::size_t j = 0; j < size; ++j) {
+            attacks[entry.index(occupancies[j])] = references[j];
+        }
+#else
+        bool found = false;
+        while (!found) {
+            do {
+                entry.magic = rng.next_sparse();
+            } while (popcount((entry.mask * entry.magic) >> 56) < 6);
+            ++attempt;
+            found = true;
+            for (std::size_t j = 0; j < size; ++j) {
+                const std::size_t index = entry.index(occupancies[j]);
+                if (epochs[index] < attempt) {
+                    epochs[index] = attempt;
+                    attacks[index] = references[j];
+                } else if (attacks[index] != references[j]) {
+                    found = false;
+                    break;
+                }
+            }
+        }
+#endif
+    }
+    assert(next_attacks == table.data() + table.size());
+}
+
+
+} // namespace
+
+
+SliderAttackTables::SliderAttackTables() noexcept
+    : rook_entries()
+    , bishop_entries()
+    , rook_table()
+    , bishop_table() {
+    init_slider_table(rook_entries, rook_table, rook_ray_attacks);
+    init_slider_table(bishop_entries, bishop_table, bishop_ray_attacks);
+}
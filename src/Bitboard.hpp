@@ -0,0 +1,345 @@
+#ifndef SUCKER_CHESS_BITBOARD_HPP
+#define SUCKER_CHESS_BITBOARD_HPP
+
+#include <array>       // for std::array
+#include <bit>         // for std::countr_zero, std::popcount
+#include <cassert>     // for assert
+#include <cstddef>     // for std::size_t
+#include <cstdint>     // for std::uint64_t
+#include <type_traits> // for std::is_constant_evaluated
+
+#ifdef __BMI2__
+#include <immintrin.h> // for _pext_u64
+#endif
+
+#include "ChessMove.hpp"
+#include "ChessPiece.hpp"
+
+
+using bitboard_t = std::uint64_t;
+constexpr std::size_t NUM_SQUARES = NUM_FILES * NUM_RANKS;
+static_assert(NUM_SQUARES == 64);
+
+
+// Squares are indexed in file-major order (a1 = 0, a2 = 1, ..., h8 = 63),
+// so visiting the set bits of a bitboard from least to most significant
+// visits squares in the same order as a nested file/rank loop.
+
+[[nodiscard]] constexpr std::size_t square_index(ChessSquare square) noexcept {
+    assert(square.in_bounds());
+    return static_cast<std::size_t>(square.file * NUM_RANKS + square.rank);
+}
+
+[[nodiscard]] constexpr ChessSquare square_at_index(std::size_t index
+) noexcept {
+    assert(index < NUM_SQUARES);
+    return {
+        static_cast<coord_t>(index) / NUM_RANKS,
+        static_cast<coord_t>(index) % NUM_RANKS};
+}
+
+[[nodiscard]] constexpr bitboard_t square_bit(ChessSquare square) noexcept {
+    return bitboard_t{1} << square_index(square);
+}
+
+[[nodiscard]] constexpr int popcount(bitboard_t bitboard) noexcept {
+    return std::popcount(bitboard);
+}
+
+[[nodiscard]] constexpr ChessSquare first_square(bitboard_t bitboard
+) noexcept {
+    assert(bitboard != 0);
+    return square_at_index(static_cast<std::size_t>(std::countr_zero(bitboard))
+    );
+}
+
+template <typename F>
+constexpr void visit_squares(bitboard_t bitboard, const F &f) {
+    while (bitboard != 0) {
+        f(first_square(bitboard));
+        bitboard &= bitboard - 1;
+    }
+}
+
+
+// ============================================================= LEAPER ATTACKS
+
+
+[[nodiscard]] constexpr bitboard_t
+shifted_square_bit(ChessSquare square, coord_t file_offset, coord_t rank_offset)
+    noexcept {
+    const ChessSquare shifted = square.shift(file_offset, rank_offset);
+    return shifted.in_bounds() ? square_bit(shifted) : bitboard_t{0};
+}
+
+
+constexpr std::array<bitboard_t, NUM_SQUARES> KING_ATTACKS = []() {
+    std::array<bitboard_t, NUM_SQUARES> result = {};
+    for (std::size_t i = 0; i < NUM_SQUARES; ++i) {
+        const ChessSquare square = square_at_index(i);
+        result[i] = shifted_square_bit(square, -1, -1) |
+                    shifted_square_bit(square, -1, 0) |
+                    shifted_square_bit(square, -1, +1) |
+                    shifted_square_bit(square, 0, -1) |
+                    shifted_square_bit(square, 0, +1) |
+                    shifted_square_bit(square, +1, -1) |
+                    shifted_square_bit(square, +1, 0) |
+                    shifted_square_bit(square, +1, +1);
+    }
+    return result;
+}();
+
+
+constexpr std::array<bitboard_t, NUM_SQUARES> KNIGHT_ATTACKS = []() {
+    std::array<bitboard_t, NUM_SQUARES> result = {};
+    for (std::size_t i = 0; i < NUM_SQUARES; ++i) {
+        const ChessSquare square = square_at_index(i);
+        result[i] = shifted_square_bit(square, -2, -1) |
+                    shifted_square_bit(square, -2, +1) |
+                    shifted_square_bit(square, -1, -2) |
+                    shifted_square_bit(square, -1, +2) |
+                    shifted_square_bit(square, +1, -2) |
+                    shifted_square_bit(square, +1, +2) |
+                    shifted_square_bit(square, +2, -1) |
+                    shifted_square_bit(square, +2, +1);
+    }
+    return result;
+}();
+
+
+// squares attacked by a white pawn standing on the given square
+constexpr std::array<bitboard_t, NUM_SQUARES> WHITE_PAWN_ATTACKS = []() {
+    std::array<bitboard_t, NUM_SQUARES> result = {};
+    for (std::size_t i = 0; i < NUM_SQUARES; ++i) {
+        const ChessSquare square = square_at_index(i);
+        result[i] = shifted_square_bit(square, -1, +1) |
+                    shifted_square_bit(square, +1, +1);
+    }
+    return result;
+}();
+
+
+// squares attacked by a black pawn standing on the given square
+constexpr std::array<bitboard_t, NUM_SQUARES> BLACK_PAWN_ATTACKS = []() {
+    std::array<bitboard_t, NUM_SQUARES> result = {};
+    for (std::size_t i = 0; i < NUM_SQUARES; ++i) {
+        const ChessSquare square = square_at_index(i);
+        result[i] = shifted_square_bit(square, -1, -1) |
+                    shifted_square_bit(square, +1, -1);
+    }
+    return result;
+}();
+
+
+[[nodiscard]] constexpr bitboard_t
+pawn_attacks(PieceColor color, ChessSquare square) noexcept {
+    switch (color) {
+        case PieceColor::NONE: __builtin_unreachable();
+        case PieceColor::WHITE: return WHITE_PAWN_ATTACKS[square_index(square)];
+        case PieceColor::BLACK: return BLACK_PAWN_ATTACKS[square_index(square)];
+    }
+    __builtin_unreachable();
+}
+
+
+// ========================================================= SLIDER RAY WALKS
+
+
+[[nodiscard]] constexpr bitboard_t ray_attacks(
+    ChessSquare square,
+    bitboard_t occupied,
+    coord_t file_offset,
+    coord_t rank_offset
+) noexcept {
+    bitboard_t result = 0;
+    ChessSquare current = square.shift(file_offset, rank_offset);
+    while (current.in_bounds()) {
+        const bitboard_t bit = square_bit(current);
+        result |= bit;
+        if (occupied & bit) { break; }
+        current = current.shift(file_offset, rank_offset);
+    }
+    return result;
+}
+
+
+[[nodiscard]] constexpr bitboard_t
+rook_ray_attacks(ChessSquare square, bitboard_t occupied) noexcept {
+    return ray_attacks(square, occupied, -1, 0) |
+           ray_attacks(square, occupied, 0, -1) |
+           ray_attacks(square, occupied, 0, +1) |
+           ray_attacks(square, occupied, +1, 0);
+}
+
+
+[[nodiscard]] constexpr bitboard_t
+bishop_ray_attacks(ChessSquare square, bitboard_t occupied) noexcept {
+    return ray_attacks(square, occupied, -1, -1) |
+           ray_attacks(square, occupied, -1, +1) |
+           ray_attacks(square, occupied, +1, -1) |
+           ray_attacks(square, occupied, +1, +1);
+}
+
+
+// ============================================================== ALIGNED PAIRS
+
+
+// squares strictly between two squares on a common rank, file, or diagonal
+// (empty if the squares are not aligned)
+constexpr std::array<std::array<bitboard_t, NUM_SQUARES>, NUM_SQUARES>
+    SQUARES_BETWEEN = []() {
+        std::array<std::array<bitboard_t, NUM_SQUARES>, NUM_SQUARES> result =
+            {};
+        for (std::size_t i = 0; i < NUM_SQUARES; ++i) {
+            const ChessSquare square = square_at_index(i);
+            for (coord_t file_offset = -1; file_offset <= +1; ++file_offset) {
+                for (coord_t rank_offset = -1; rank_offset <= +1;
+                     ++rank_offset) {
+                    if (file_offset == 0 && rank_offset == 0) { continue; }
+                    bitboard_t path = 0;
+                    ChessSquare current =
+                        square.shift(file_offset, rank_offset);
+                    while (current.in_bounds()) {
+                        result[i][square_index(current)] = path;
+                        path |= square_bit(current);
+                        current = current.shift(file_offset, rank_offset);
+                    }
+                }
+            }
+        }
+        return result;
+    }();
+
+
+// entire line (edge to edge) through two squares on a common rank, file, or
+// diagonal (empty if the squares are not aligned)
+constexpr std::array<std::array<bitboard_t, NUM_SQUARES>, NUM_SQUARES>
+    LINES_THROUGH = []() {
+        std::array<std::array<bitboard_t, NUM_SQUARES>, NUM_SQUARES> result =
+            {};
+        for (std::size_t i = 0; i < NUM_SQUARES; ++i) {
+            const ChessSquare square = square_at_index(i);
+            for (coord_t file_offset = -1; file_offset <= +1; ++file_offset) {
+                for (coord_t rank_offset = -1; rank_offset <= +1;
+                     ++rank_offset) {
+                    if (file_offset == 0 && rank_offset == 0) { continue; }
+                    const bitboard_t forward =
+                        ray_attacks(square, 0, file_offset, rank_offset);
+                    const bitboard_t backward =
+                        ray_attacks(square, 0, -file_offset, -rank_offset);
+                    const bitboard_t line =
+                        forward | backward | square_bit(square);
+                    visit_squares(forward, [&](ChessSquare other) {
+                        result[i][square_index(other)] = line;
+                    });
+                }
+            }
+        }
+        return result;
+    }();
+
+
+[[nodiscard]] constexpr bitboard_t
+squares_between(ChessSquare a, ChessSquare b) noexcept {
+    return SQUARES_BETWEEN[square_index(a)][square_index(b)];
+}
+
+
+[[nodiscard]] constexpr bitboard_t
+line_through(ChessSquare a, ChessSquare b) noexcept {
+    return LINES_THROUGH[square_index(a)][square_index(b)];
+}
+
+
+// ======================================================= SLIDER ATTACK TABLES
+
+
+struct MagicEntry {
+
+    bitboard_t mask; // squares whose occupancy can block this slider
+    bitboard_t magic;
+    const bitboard_t *attacks;
+    unsigned shift;
+
+    [[nodiscard]] std::size_t index(bitboard_t occupied) const noexcept {
+#ifdef __BMI2__
+        return static_cast<std::size_t>(_pext_u64(occupied, mask));
+#else
+        return static_cast<std::size_t>(((occupied & mask) * magic) >> shift);
+#endif
+    }
+
+    [[nodiscard]] bitboard_t lookup(bitboard_t occupied) const noexcept {
+        return attacks[index(occupied)];
+    }
+
+}; // struct MagicEntry
+
+
+class SliderAttackTables final {
+
+    std::array<MagicEntry, NUM_SQUARES> rook_entries;
+    std::array<MagicEntry, NUM_SQUARES> bishop_entries;
+    std::array<bitboard_t, 0x19000> rook_table;
+    std::array<bitboard_t, 0x1480> bishop_table;
+
+public: // ========================================================= CONSTRUCTOR
+
+    // Fills every table entry, searching for magic numbers when PEXT is not
+    // available. This is expensive; use the shared instance returned by
+    // slider_attack_tables() rather than constructing new tables.
+    explicit SliderAttackTables() noexcept;
+
+    SliderAttackTables(const SliderAttackTables &) = delete;
+    SliderAttackTables &operator=(const SliderAttackTables &) = delete;
+
+public: // ============================================================= LOOKUPS
+
+    [[nodiscard]] bitboard_t
+    rook_attacks(ChessSquare square, bitboard_t occupied) const noexcept {
+        return rook_entries[square_index(square)].lookup(occupied);
+    }
+
+    [[nodiscard]] bitboard_t
+    bishop_attacks(ChessSquare square, bitboard_t occupied) const noexcept {
+        return bishop_entries[square_index(square)].lookup(occupied);
+    }
+
+}; // class SliderAttackTables
+
+
+// Returns the process-wide slider attack tables, which are built on first use.
+[[nodiscard]] inline const SliderAttackTables &slider_attack_tables() noexcept {
+    static const SliderAttackTables tables;
+    return tables;
+}
+
+
+// ============================================================= SLIDER ATTACKS
+
+
+[[nodiscard]] constexpr bitboard_t
+rook_attacks(ChessSquare square, bitboard_t occupied) noexcept {
+    if (std::is_constant_evaluated()) {
+        return rook_ray_attacks(square, occupied);
+    }
+    return slider_attack_tables().rook_attacks(square, occupied);
+}
+
+
+[[nodiscard]] constexpr bitboard_t
+bishop_attacks(ChessSquare square, bitboard_t occupied) noexcept {
+    if (std::is_constant_evaluated()) {
+        return bishop_ray_attacks(square, occupied);
+    }
+    return slider_attack_tables().bishop_attacks(square, occupied);
+}
+
+
+[[nodiscard]] constexpr bitboard_t
+queen_attacks(ChessSquare square, bitboard_t occupied) noexcept {
+    return rook_attacks(square, occupied) | bishop_attacks(square, occupied);
+}
+
+
+#endif // SUCKER_CHESS_BITBOARD_HPP
@@ -4,7 +4,17 @@
 
 
 ChessBoard::ChessBoard(const std::string &fen_board_str)
-    : data() {
+#ifdef SUCKER_CHESS_USE_BITBOARDS
+    : color_data()
+    , type_data()
+    , mailbox()
+#else
+    : data()
+#ifdef SUCKER_CHESS_TRACK_PIECE_COUNTS
+    , piece_counts()
+#endif
+#endif
+{
 
     // start in top-left corner of board
     coord_t file = 0;
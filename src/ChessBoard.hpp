@@ -8,22 +8,51 @@
 #include <ostream> // for std::ostream
 #include <string>  // for std::string
 
+#include "Bitboard.hpp"
 #include "ChessMove.hpp"
 #include "ChessPiece.hpp"
 
 
+#if defined(SUCKER_CHESS_USE_BITBOARDS) &&                                     \
+    defined(SUCKER_CHESS_USE_COMPRESSED_CHESS_BOARD)
+#error "SUCKER_CHESS_USE_BITBOARDS and SUCKER_CHESS_USE_COMPRESSED_CHESS_BOARD are mutually exclusive"
+#endif
+
+
 class ChessBoard final {
 
-#ifdef SUCKER_CHESS_USE_COMPRESSED_CHESS_BOARD
+#ifdef SUCKER_CHESS_USE_BITBOARDS
+    // The bitboards are authoritative for attack and move generation, while
+    // the mailbox (indexed by square_index) answers get_piece in one load.
+    std::array<bitboard_t, 2> color_data; // indexed by PieceColor - 1
+    std::array<bitboard_t, 6> type_data;  // indexed by PieceType - 1
+    std::array<ChessPiece, NUM_SQUARES> mailbox;
+#elif defined(SUCKER_CHESS_USE_COMPRESSED_CHESS_BOARD)
     static_assert(NUM_RANKS % 2 == 0);
     std::array<std::array<std::uint8_t, NUM_RANKS / 2>, NUM_FILES> data;
 #else
     std::array<std::array<ChessPiece, NUM_RANKS>, NUM_FILES> data;
 #endif
 
+#if defined(SUCKER_CHESS_TRACK_PIECE_COUNTS) &&                                \
+    !defined(SUCKER_CHESS_USE_BITBOARDS)
+    // number of pieces of each kind on the board, maintained by set_piece
+    // (bitboards count pieces with a single popcount instead)
+    std::array<std::uint8_t, 12> piece_counts; // indexed like piece_index
+#endif
+
 public: // ========================================================= CONSTRUCTOR
 
-    explicit constexpr ChessBoard() noexcept {
+    explicit constexpr ChessBoard() noexcept
+#ifdef SUCKER_CHESS_USE_BITBOARDS
+        : color_data()
+        , type_data()
+        , mailbox()
+#elif defined(SUCKER_CHESS_TRACK_PIECE_COUNTS)
+        : data()
+        , piece_counts()
+#endif
+    {
 
         // begin with all squares empty
         for (coord_t file = 0; file < NUM_FILES; ++file) {
@@ -101,12 +130,65 @@ private: // ================================================ COMPRESSION HELPERS
 
 #endif
 
+#if defined(SUCKER_CHESS_TRACK_PIECE_COUNTS) &&                                \
+    !defined(SUCKER_CHESS_USE_BITBOARDS)
+
+private: // ============================================= PIECE COUNTING HELPERS
+
+    static constexpr std::size_t piece_index(ChessPiece piece) noexcept {
+        assert(piece != EMPTY_SQUARE);
+        return 6 * (static_cast<std::size_t>(piece.get_color()) - 1) +
+               (static_cast<std::size_t>(piece.get_type()) - 1);
+    }
+
+#endif
+
+#ifdef SUCKER_CHESS_USE_BITBOARDS
+
+private: // ==================================================== BITBOARD HELPERS
+
+    static constexpr std::size_t color_index(PieceColor color) noexcept {
+        assert(color != PieceColor::NONE);
+        return static_cast<std::size_t>(color) - 1;
+    }
+
+    static constexpr std::size_t type_index(PieceType type) noexcept {
+        assert(type != PieceType::NONE);
+        return static_cast<std::size_t>(type) - 1;
+    }
+
+public: // ================================================== BITBOARD ACCESSORS
+
+    [[nodiscard]] constexpr bitboard_t get_occupied() const noexcept {
+        return color_data[0] | color_data[1];
+    }
+
+    [[nodiscard]] constexpr bitboard_t get_color_bitboard(PieceColor color
+    ) const noexcept {
+        return color_data[color_index(color)];
+    }
+
+    [[nodiscard]] constexpr bitboard_t get_type_bitboard(PieceType type
+    ) const noexcept {
+        return type_data[type_index(type)];
+    }
+
+    [[nodiscard]] constexpr bitboard_t get_piece_bitboard(ChessPiece piece
+    ) const noexcept {
+        return get_color_bitboard(piece.get_color()) &
+               get_type_bitboard(piece.get_type());
+    }
+
+#endif
+
 public: // =========================================================== ACCESSORS
 
     [[nodiscard]] constexpr ChessPiece get_piece(ChessSquare square
     ) const noexcept {
         assert(square.in_bounds());
-#ifdef SUCKER_CHESS_USE_COMPRESSED_CHESS_BOARD
+#ifdef SUCKER_CHESS_USE_BITBOARDS
+        return mailbox[square_index(square)];
+#elif defined(SUCKER_CHESS_USE_COMPRESSED_CHESS_BOARD)
         const std::uint8_t cell =
             data[static_cast<std::size_t>(square.file)]
                 [static_cast<std::size_t>(square.rank / 2)];
@@ -130,6 +212,27 @@ public: // ============================================================ MUTATORS
 
     constexpr void set_piece(ChessSquare square, ChessPiece piece) noexcept {
         assert(square.in_bounds());
+#ifdef SUCKER_CHESS_USE_BITBOARDS
+        const std::size_t index = square_index(square);
+        const bitboard_t bit = square_bit(square);
+        const ChessPiece old_piece = mailbox[index];
+        if (old_piece != EMPTY_SQUARE) {
+            color_data[color_index(old_piece.get_color())] &= ~bit;
+            type_data[type_index(old_piece.get_type())] &= ~bit;
+        }
+        if (piece != EMPTY_SQUARE) {
+            color_data[color_index(piece.get_color())] |= bit;
+            type_data[type_index(piece.get_type())] |= bit;
+        }
+        mailbox[index] = piece;
+#else
+#ifdef SUCKER_CHESS_TRACK_PIECE_COUNTS
+        const ChessPiece old_piece = get_piece(square);
+        if (old_piece != EMPTY_SQUARE) {
+            --piece_counts[piece_index(old_piece)];
+        }
+        if (piece != EMPTY_SQUARE) { ++piece_counts[piece_index(piece)]; }
+#endif
 #ifdef SUCKER_CHESS_USE_COMPRESSED_CHESS_BOARD
         const auto file = static_cast<std::size_t>(square.file);
         const auto rank = static_cast<std::size_t>(square.rank);
@@ -145,6 +248,7 @@ public: // ============================================================ MUTATORS
 #else
         data[static_cast<std::size_t>(square.file)]
             [static_cast<std::size_t>(square.rank)] = piece;
+#endif
 #endif
     }
 
@@ -153,6 +257,31 @@ public: // ============================================================ MUTATORS
         set_piece({file, rank}, piece);
     }
 
+#ifdef SUCKER_CHESS_USE_BITBOARDS
+
+    // equivalent to set_piece(square, piece) when square is empty
+    constexpr void put_piece(ChessSquare square, ChessPiece piece) noexcept {
+        assert(get_piece(square) == EMPTY_SQUARE);
+        assert(piece != EMPTY_SQUARE);
+        const bitboard_t bit = square_bit(square);
+        color_data[color_index(piece.get_color())] |= bit;
+        type_data[type_index(piece.get_type())] |= bit;
+        mailbox[square_index(square)] = piece;
+    }
+
+    // equivalent to set_piece(square, EMPTY_SQUARE) when square is occupied
+    constexpr void remove_piece(ChessSquare square) noexcept {
+        const std::size_t index = square_index(square);
+        const ChessPiece piece = mailbox[index];
+        assert(piece != EMPTY_SQUARE);
+        const bitboard_t bit = square_bit(square);
+        color_data[color_index(piece.get_color())] &= ~bit;
+        type_data[type_index(piece.get_type())] &= ~bit;
+        mailbox[index] = EMPTY_SQUARE;
+    }
+
+#endif
+
 public: // ========================================================== COMPARISON
 
     constexpr bool operator==(const ChessBoard &) const noexcept = default;
@@ -194,6 +323,9 @@ public: // =========================================================== SEARCHING
 
     [[nodiscard]] constexpr ChessSquare find_first_piece(ChessPiece piece
     ) const noexcept {
+#ifdef SUCKER_CHESS_USE_BITBOARDS
+        return first_square(get_piece_bitboard(piece));
+#else
         for (coord_t file = 0; file < NUM_FILES; ++file) {
             for (coord_t rank = 0; rank < NUM_RANKS; ++rank) {
                 const ChessSquare square = {file, rank};
@@ -201,6 +333,7 @@ public: // =========================================================== SEARCHING
             }
         }
         __builtin_unreachable();
+#endif
     }
 
     [[nodiscard]] ChessSquare find_unique_piece(ChessPiece piece) const;
@@ -208,6 +341,11 @@ public: // =========================================================== SEARCHING
 public: // ============================================================ COUNTING
 
     [[nodiscard]] constexpr int count(ChessPiece piece) const noexcept {
+#ifdef SUCKER_CHESS_USE_BITBOARDS
+        return popcount(get_piece_bitboard(piece));
+#elif defined(SUCKER_CHESS_TRACK_PIECE_COUNTS)
+        return piece_counts[piece_index(piece)];
+#else
         int result = 0;
         for (coord_t file = 0; file < NUM_FILES; ++file) {
             for (coord_t rank = 0; rank < NUM_RANKS; ++rank) {
@@ -215,9 +353,22 @@ public: // ============================================================ COUNTING
             }
         }
         return result;
+#endif
     }
 
     [[nodiscard]] constexpr bool has_insufficient_material() const noexcept {
+#ifdef SUCKER_CHESS_USE_BITBOARDS
+        // Same test as below, on the union of both colors' bitboards.
+        if ((get_type_bitboard(PieceType::QUEEN) |
+             get_type_bitboard(PieceType::ROOK) |
+             get_type_bitboard(PieceType::PAWN)) != 0) {
+            return false;
+        }
+        return popcount(
+                   get_type_bitboard(PieceType::BISHOP) |
+                   get_type_bitboard(PieceType::KNIGHT)
+               ) <= 1;
+#else
         // If either side has a queen, rook, or pawn,
         // then checkmate is possible.
         if (count(WHITE_QUEEN) != 0) { return false; }
@@ -231,6 +382,7 @@ public: // ============================================================ COUNTING
         const int white_piece_count = count(WHITE_BISHOP) + count(WHITE_KNIGHT);
         const int black_piece_count = count(BLACK_BISHOP) + count(BLACK_KNIGHT);
         return (white_piece_count + black_piece_count <= 1);
+#endif
     }
 
 public: // ====================================================== PAWN UTILITIES
@@ -274,6 +426,10 @@ public: // ====================================================== LEAPER ATTACKS
     is_attacked_by_king(PieceColor color, ChessSquare square) const noexcept {
         assert(color != PieceColor::NONE);
         assert(square.in_bounds());
+#ifdef SUCKER_CHESS_USE_BITBOARDS
+        return (KING_ATTACKS[square_index(square)] &
+                get_piece_bitboard({color, PieceType::KING})) != 0;
+#else
         const ChessPiece king = {color, PieceType::KING};
         return in_bounds_and_has_piece(square.shift(-1, -1), king) ||
                in_bounds_and_has_piece(square.shift(-1, 0), king) ||
@@ -283,12 +439,19 @@ public: // ====================================================== LEAPER ATTACKS
                in_bounds_and_has_piece(square.shift(+1, -1), king) ||
                in_bounds_and_has_piece(square.shift(+1, 0), king) ||
                in_bounds_and_has_piece(square.shift(+1, +1), king);
+#endif
     }
 
     [[nodiscard]] constexpr int
     count_king_attacks(PieceColor color, ChessSquare square) const noexcept {
         assert(color != PieceColor::NONE);
         assert(square.in_bounds());
+#ifdef SUCKER_CHESS_USE_BITBOARDS
+        return popcount(
+            KING_ATTACKS[square_index(square)] &
+            get_piece_bitboard({color, PieceType::KING})
+        );
+#else
         const ChessPiece king = {color, PieceType::KING};
         int result = 0;
         if (in_bounds_and_has_piece(square.shift(-1, -1), king)) { ++result; }
@@ -300,12 +463,17 @@ public: // ====================================================== LEAPER ATTACKS
         if (in_bounds_and_has_piece(square.shift(+1, 0), king)) { ++result; }
         if (in_bounds_and_has_piece(square.shift(+1, +1), king)) { ++result; }
         return result;
+#endif
     }
 
     [[nodiscard]] constexpr bool
     is_attacked_by_knight(PieceColor color, ChessSquare square) const noexcept {
         assert(color != PieceColor::NONE);
         assert(square.in_bounds());
+#ifdef SUCKER_CHESS_USE_BITBOARDS
+        return (KNIGHT_ATTACKS[square_index(square)] &
+                get_piece_bitboard({color, PieceType::KNIGHT})) != 0;
+#else
         const ChessPiece knight = {color, PieceType::KNIGHT};
         return in_bounds_and_has_piece(square.shift(-2, -1), knight) ||
                in_bounds_and_has_piece(square.shift(-2, +1), knight) ||
@@ -315,12 +483,19 @@ public: // ====================================================== LEAPER ATTACKS
                in_bounds_and_has_piece(square.shift(+1, +2), knight) ||
                in_bounds_and_has_piece(square.shift(+2, -1), knight) ||
                in_bounds_and_has_piece(square.shift(+2, +1), knight);
+#endif
     }
 
     [[nodiscard]] constexpr int
     count_knight_attacks(PieceColor color, ChessSquare square) const noexcept {
         assert(color != PieceColor::NONE);
         assert(square.in_bounds());
+#ifdef SUCKER_CHESS_USE_BITBOARDS
+        return popcount(
+            KNIGHT_ATTACKS[square_index(square)] &
+            get_piece_bitboard({color, PieceType::KNIGHT})
+        );
+#else
         const ChessPiece knight = {color, PieceType::KNIGHT};
         int result = 0;
         if (in_bounds_and_has_piece(square.shift(-2, -1), knight)) { ++result; }
@@ -332,28 +507,105 @@ public: // ====================================================== LEAPER ATTACKS
         if (in_bounds_and_has_piece(square.shift(+2, -1), knight)) { ++result; }
         if (in_bounds_and_has_piece(square.shift(+2, +1), knight)) { ++result; }
         return result;
+#endif
     }
 
     [[nodiscard]] constexpr bool
     is_attacked_by_pawn(PieceColor color, ChessSquare square) const noexcept {
         assert(color != PieceColor::NONE);
         assert(square.in_bounds());
+#ifdef SUCKER_CHESS_USE_BITBOARDS
+        // a pawn of the given color attacks this square exactly when
+        // a pawn of the opposite color here would attack the pawn
+        return (pawn_attacks(!color, square) &
+                get_piece_bitboard({color, PieceType::PAWN})) != 0;
+#else
         const ChessPiece pawn = {color, PieceType::PAWN};
         const coord_t direction = pawn_direction(color);
         return in_bounds_and_has_piece(square.shift(-1, -direction), pawn) ||
                in_bounds_and_has_piece(square.shift(+1, -direction), pawn);
+#endif
     }
 
     [[nodiscard]] constexpr int
     count_pawn_attacks(PieceColor color, ChessSquare square) const noexcept {
         assert(color != PieceColor::NONE);
         assert(square.in_bounds());
+#ifdef SUCKER_CHESS_USE_BITBOARDS
+        return popcount(
+            pawn_attacks(!color, square) &
+            get_piece_bitboard({color, PieceType::PAWN})
+        );
+#else
         const ChessPiece pawn = {color, PieceType::PAWN};
         const coord_t direction = pawn_direction(color);
         return in_bounds_and_has_piece(square.shift(-1, -direction), pawn) +
                in_bounds_and_has_piece(square.shift(+1, -direction), pawn);
+#endif
+    }
+
+#ifdef SUCKER_CHESS_USE_BITBOARDS
+
+private: // ============================================== SLIDER ATTACK HELPERS
+
+    [[nodiscard]] constexpr bitboard_t orthogonal_sliders(PieceColor color
+    ) const noexcept {
+        return get_color_bitboard(color) &
+               (get_type_bitboard(PieceType::QUEEN) |
+                get_type_bitboard(PieceType::ROOK));
+    }
+
+    [[nodiscard]] constexpr bitboard_t diagonal_sliders(PieceColor color
+    ) const noexcept {
+        return get_color_bitboard(color) &
+               (get_type_bitboard(PieceType::QUEEN) |
+                get_type_bitboard(PieceType::BISHOP));
+    }
+
+private: // ===================================================== SLIDER ATTACKS
+
+    [[nodiscard]] constexpr bool is_attacked_orthogonally(
+        PieceColor color, ChessSquare square
+    ) const noexcept {
+        assert(color != PieceColor::NONE);
+        assert(square.in_bounds());
+        const bitboard_t sliders = orthogonal_sliders(color);
+        return (sliders != 0) &&
+               ((rook_attacks(square, get_occupied()) & sliders) != 0);
+    }
+
+    [[nodiscard]] constexpr int count_orthogonal_attacks(
+        PieceColor color, ChessSquare square
+    ) const noexcept {
+        assert(color != PieceColor::NONE);
+        assert(square.in_bounds());
+        return popcount(
+            rook_attacks(square, get_occupied()) & orthogonal_sliders(color)
+        );
+    }
+
+    [[nodiscard]] constexpr bool is_attacked_diagonally(
+        PieceColor color, ChessSquare square
+    ) const noexcept {
+        assert(color != PieceColor::NONE);
+        assert(square.in_bounds());
+        const bitboard_t sliders = diagonal_sliders(color);
+        return (sliders != 0) &&
+               ((bishop_attacks(square, get_occupied()) & sliders) != 0);
     }
 
+    [[nodiscard]] constexpr int count_diagonal_attacks(
+        PieceColor color, ChessSquare square
+    ) const noexcept {
+        assert(color != PieceColor::NONE);
+        assert(square.in_bounds());
+        return popcount(
+            bishop_attacks(square, get_occupied()) & diagonal_sliders(color)
+        );
+    }
+
+#else
+
 private: // ============================================== SLIDER ATTACK HELPERS
 
     [[nodiscard]] constexpr ChessPiece find_slider(
@@ -447,6 +699,8 @@ private: // ===================================================== SLIDER ATTACKS
         return result;
     }
 
+#endif
+
 public: // ====================================================== ATTACK TESTING
 
     [[nodiscard]] constexpr bool
@@ -471,6 +725,114 @@ public: // ====================================================== ATTACK TESTING
                count_king_attacks(color, square);
     }
 
+    // Returns the set of squares attacked by at least one piece of the given
+    // color, computed in a single pass over that color's pieces. A square is
+    // in this set exactly when is_attacked_by(color, square) is true.
+    [[nodiscard]] constexpr bitboard_t attack_map(PieceColor color
+    ) const noexcept {
+        assert(color != PieceColor::NONE);
+        using enum PieceType;
+#ifdef SUCKER_CHESS_USE_BITBOARDS
+        const bitboard_t occupied = get_occupied();
+        const bitboard_t pawns = get_piece_bitboard({color, PAWN});
+        const bitboard_t knights = get_piece_bitboard({color, KNIGHT});
+        bitboard_t result = 0;
+        visit_squares(pawns, [&](ChessSquare src) {
+            result |= pawn_attacks(color, src);
+        });
+        visit_squares(knights, [&](ChessSquare src) {
+            result |= KNIGHT_ATTACKS[square_index(src)];
+        });
+        visit_squares(diagonal_sliders(color), [&](ChessSquare src) {
+            result |= bishop_attacks(src, occupied);
+        });
+        visit_squares(orthogonal_sliders(color), [&](ChessSquare src) {
+            result |= rook_attacks(src, occupied);
+        });
+        visit_squares(get_piece_bitboard({color, KING}), [&](ChessSquare src) {
+            result |= KING_ATTACKS[square_index(src)];
+        });
+        return result;
+#else
+        bitboard_t occupied = 0;
+        for (coord_t file = 0; file < NUM_FILES; ++file) {
+            for (coord_t rank = 0; rank < NUM_RANKS; ++rank) {
+                if (get_piece(file, rank) != EMPTY_SQUARE) {
+                    occupied |= square_bit({file, rank});
+                }
+            }
+        }
+        bitboard_t result = 0;
+        for (coord_t file = 0; file < NUM_FILES; ++file) {
+            for (coord_t rank = 0; rank < NUM_RANKS; ++rank) {
+                const ChessSquare src = {file, rank};
+                const ChessPiece piece = get_piece(src);
+                if (piece.get_color() != color) { continue; }
+                switch (piece.get_type()) {
+                    case NONE: __builtin_unreachable();
+                    case KING: result |= KING_ATTACKS[square_index(src)]; break;
+                    case QUEEN: result |= queen_attacks(src, occupied); break;
+                    case ROOK: result |= rook_attacks(src, occupied); break;
+                    case BISHOP: result |= bishop_attacks(src, occupied); break;
+                    case KNIGHT:
+                        result |= KNIGHT_ATTACKS[square_index(src)];
+                        break;
+                    case PAWN: result |= pawn_attacks(color, src); break;
+                }
+            }
+        }
+        return result;
+#endif
+    }
+
+#ifdef SUCKER_CHESS_USE_BITBOARDS
+
+public: // ======================================================= ATTACKER SETS
+
+    // Returns the pieces of the given color that attack the given square,
+    // treating exactly the squares in `occupied` as blockers of slider rays.
+    [[nodiscard]] constexpr bitboard_t attackers_of(
+        PieceColor color, ChessSquare square, bitboard_t occupied
+    ) const noexcept {
+        assert(color != PieceColor::NONE);
+        assert(square.in_bounds());
+        const std::size_t index = square_index(square);
+        const bitboard_t leapers =
+            (pawn_attacks(!color, square) &
+             get_type_bitboard(PieceType::PAWN)) |
+            (KNIGHT_ATTACKS[index] & get_type_bitboard(PieceType::KNIGHT)) |
+            (KING_ATTACKS[index] & get_type_bitboard(PieceType::KING));
+        return (leapers & get_color_bitboard(color)) |
+               (rook_attacks(square, occupied) & orthogonal_sliders(color)) |
+               (bishop_attacks(square, occupied) & diagonal_sliders(color));
+    }
+
+    [[nodiscard]] constexpr bitboard_t
+    attackers_of(PieceColor color, ChessSquare square) const noexcept {
+        return attackers_of(color, square, get_occupied());
+    }
+
+    // Returns the pieces of the given color that are the only piece standing
+    // between the given square (normally their own king) and an enemy slider.
+    [[nodiscard]] constexpr bitboard_t
+    pinned_to(PieceColor color, ChessSquare square) const noexcept {
+        assert(color != PieceColor::NONE);
+        assert(square.in_bounds());
+        const bitboard_t occupied = get_occupied();
+        const bitboard_t snipers =
+            (rook_attacks(square, 0) & orthogonal_sliders(!color)) |
+            (bishop_attacks(square, 0) & diagonal_sliders(!color));
+        bitboard_t result = 0;
+        visit_squares(snipers, [&](ChessSquare sniper) {
+            const bitboard_t blockers =
+                squares_between(square, sniper) & occupied;
+            if (popcount(blockers) == 1) { result |= blockers; }
+        });
+        return result & get_color_bitboard(color);
+    }
+
+#endif
+
 }; // class ChessBoard
 
 
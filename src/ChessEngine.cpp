@@ -1,43 +1,36 @@
 #include "ChessEngine.hpp"
 
-#include <cassert> // for assert
-#include <utility> // for std::make_pair, std::move
-
-
-ChessEngineInterface::ChessEngineInterface() noexcept
-    : cache()
+ChessEngineInterface::ChessEngineInterface(std::size_t cache_bytes) noexcept
+    : cache(cache_bytes)
     , current_pos()
-    , current_info(&lookup(current_pos)) {}
+    , current_info()
+    , lookup_result() {
+    current_info = lookup(current_pos);
+}
 
 
 const PositionInfo &ChessEngineInterface::lookup(const ChessPosition &pos
 ) noexcept {
-    const auto location = cache.find(pos);
-    if (location != cache.end()) {
-        return location->second;
-    } else {
-        std::vector<ChessMove> legal_moves;
-        pos.visit_legal_moves([&](ChessMove move, const ChessPosition &) {
-            legal_moves.push_back(move);
+    if (!cache.find(pos, lookup_result)) {
+        lookup_result.legal_moves.clear();
+        pos.visit_legal_moves([&](ChessMove move) {
+            lookup_result.legal_moves.push_back(move);
         });
-        const bool in_check = pos.in_check();
-        const auto [iterator, inserted] = cache.insert(
-            std::make_pair(pos, PositionInfo{std::move(legal_moves), in_check})
-        );
-        assert(inserted);
-        return iterator->second;
+        lookup_result.in_check = pos.in_check();
+        cache.insert(pos, lookup_result);
     }
+    return lookup_result;
 }
 
 
-const std::vector<ChessMove> &
+const MoveList &
 ChessEngineInterface::get_legal_moves(const ChessPosition &pos) noexcept {
     return lookup(pos).legal_moves;
 }
 
 
-const std::vector<ChessMove> &ChessEngineInterface::get_legal_moves() noexcept {
-    return current_info->legal_moves;
+const MoveList &ChessEngineInterface::get_legal_moves() noexcept {
+    return current_info.legal_moves;
 }
 
 
@@ -51,7 +44,7 @@ bool ChessEngineInterface::checkmated(const ChessPosition &pos) noexcept {
 
 
 bool ChessEngineInterface::checkmated() noexcept {
-    return current_info->in_check && current_info->legal_moves.empty();
+    return current_info.in_check && current_info.legal_moves.empty();
 }
 
 
@@ -65,13 +58,13 @@ bool ChessEngineInterface::stalemated(const ChessPosition &pos) noexcept {
 
 
 bool ChessEngineInterface::stalemated() noexcept {
-    return (!current_info->in_check) && current_info->legal_moves.empty();
+    return (!current_info.in_check) && current_info.legal_moves.empty();
 }
 
 
 void ChessEngineInterface::make_move(ChessMove move) noexcept {
     current_pos.make_move(move);
-    current_info = &lookup(current_pos);
+    current_info = lookup(current_pos);
 }
 
 
@@ -1,32 +1,32 @@
 #ifndef SUCKER_CHESS_CHESS_ENGINE_HPP
 #define SUCKER_CHESS_CHESS_ENGINE_HPP
 
-#include <string>        // for std::string
-#include <unordered_map> // for std::unordered_map
-#include <vector>        // for std::vector
+#include <cstddef> // for std::size_t
+#include <memory>  // for std::unique_ptr
+#include <random>  // for std::mt19937
+#include <string>  // for std::string
+#include <vector>  // for std::vector
 
 #include "ChessMove.hpp"
 #include "ChessPiece.hpp"
 #include "ChessPosition.hpp"
-
-
-struct PositionInfo {
-
-    std::vector<ChessMove> legal_moves;
-    bool in_check;
-
-}; // class PositionInfo
+#include "MoveList.hpp"
+#include "PositionInfoCache.hpp"
 
 
 class ChessEngineInterface {
 
-    std::unordered_map<ChessPosition, PositionInfo> cache;
+    PositionInfoCache cache;
     ChessPosition current_pos;
-    const PositionInfo *current_info;
+    PositionInfo current_info;
+    PositionInfo lookup_result;
 
 public: // ========================================================= CONSTRUCTOR
 
-    explicit ChessEngineInterface() noexcept;
+    static constexpr std::size_t DEFAULT_CACHE_BYTES = 32 * 1024 * 1024;
+
+    explicit ChessEngineInterface(std::size_t cache_bytes = DEFAULT_CACHE_BYTES
+    ) noexcept;
 
 public: // =========================================================== ACCESSORS
 
@@ -41,14 +41,17 @@ public: // =========================================================== ACCESSORS
 
 public: // ======================================================== CACHE LOOKUP
 
+    // The PositionInfo returned by lookup (and the move lists returned by
+    // get_legal_moves(pos)) remain valid only until the next lookup. Callers
+    // that look up other positions while using a result must copy it first.
+    // Information about the current position is always valid.
     const PositionInfo &lookup(const ChessPosition &pos) noexcept;
 
 public: // ======================================================= STATE TESTING
 
-    const std::vector<ChessMove> &get_legal_moves(const ChessPosition &pos
-    ) noexcept;
+    const MoveList &get_legal_moves(const ChessPosition &pos) noexcept;
 
-    const std::vector<ChessMove> &get_legal_moves() noexcept;
+    const MoveList &get_legal_moves() noexcept;
 
     bool checkmated(const ChessPosition &pos) noexcept;
 
@@ -79,6 +82,19 @@ public:
 
     virtual const std::string &get_name() noexcept = 0;
 
+    // Games in compact history mode only rebuild the position history for
+    // engines that read it in pick_move, and pass an empty pos_history to
+    // all others.
+    [[nodiscard]] virtual bool needs_pos_history() const noexcept {
+        return false;
+    }
+
+    // Returns a new engine with the same configuration that shares no state
+    // with this one, so that each can be used by a different thread. Any
+    // random choices made by the clone are drawn from random_engine.
+    [[nodiscard]] virtual std::unique_ptr<ChessEngine>
+    clone(std::mt19937 random_engine) const = 0;
+
 }; // class ChessEngine
 
 
@@ -1,33 +1,65 @@
 #include "ChessGame.hpp"
 
-#include <cassert>  // for assert
-#include <cstddef>  // for std::size_t
-#include <iostream> // for std::cin, std::cout, std::endl
-#include <sstream>  // for std::ostringstream
-#include <string>   // for std::getline
+#include <algorithm>  // for std::min
+#include <cassert>    // for assert
+#include <cstddef>    // for std::size_t
+#include <cstdint>    // for std::uint64_t
+#include <functional> // for std::hash
+#include <iostream>   // for std::cin, std::cout, std::endl
+#include <sstream>    // for std::ostringstream
+#include <string>     // for std::getline
 
 #include "Utilities.hpp"
 
 
-ChessGame::ChessGame() noexcept
+ChessGame::ChessGame(bool compact_history) noexcept
     : m_interface()
     , m_status(GameStatus::IN_PROGRESS)
+    , m_compact_history(compact_history)
     , m_pos_history()
+    , m_hash_history()
     , m_move_history()
     , m_half_move_clock(0)
     , m_full_move_count(1) {}
 
 
+const std::vector<ChessPosition> &ChessGame::get_pos_history() noexcept {
+    while (m_pos_history.size() < m_move_history.size()) {
+        m_pos_history.push_back(get_pos(m_pos_history.size()));
+    }
+    return m_pos_history;
+}
+
+
+ChessPosition ChessGame::get_pos(std::size_t index) const noexcept {
+    assert(index < m_move_history.size());
+    if (index < m_pos_history.size()) { return m_pos_history[index]; }
+    std::size_t i = m_pos_history.empty() ? 0 : m_pos_history.size() - 1;
+    ChessPosition result =
+        m_pos_history.empty() ? ChessPosition() : m_pos_history.back();
+    for (; i < index; ++i) { result.make_move(m_move_history[i]); }
+    return result;
+}
+
+
 GameStatus ChessGame::compute_current_status() noexcept {
 
     using enum PieceColor;
     using enum GameStatus;
 
-    // before anything else, check for threefold repetition
+    // before anything else, check for threefold repetition. Only positions
+    // with the same player to move (every other entry) since the last
+    // capture or pawn move (which cannot be undone) can repeat, and only
+    // positions with matching hashes need to be compared in full.
     int count = 0;
     const ChessPosition &cur = m_interface.get_current_pos();
-    for (const ChessPosition &pos : m_pos_history) {
-        if (cur == pos) {
+    const std::uint64_t cur_hash = std::hash<ChessPosition>{}(cur);
+    const std::size_t size = m_hash_history.size();
+    const std::size_t reversible =
+        std::min(size, static_cast<std::size_t>(get_half_move_clock()));
+    for (std::size_t back = 2; back <= reversible; back += 2) {
+        const std::size_t i = size - back;
+        if ((m_hash_history[i] == cur_hash) && (get_pos(i) == cur)) {
             ++count;
             if (count >= 2) { return DRAWN_BY_REPETITION; }
         }
@@ -58,7 +90,7 @@ GameStatus ChessGame::compute_current_status() noexcept {
 ChessMove ChessGame::get_console_move() {
 
     // retrieve legal moves and names, with and without +/# suffixes
-    const std::vector<ChessMove> &legal_moves = m_interface.get_legal_moves();
+    const MoveList &legal_moves = m_interface.get_legal_moves();
     std::vector<std::string> base_names;
     std::vector<std::string> suffixed_names;
     for (const ChessMove &move : legal_moves) {
@@ -109,7 +141,12 @@ void ChessGame::make_move(ChessMove move) noexcept {
     assert(get_current_status() == GameStatus::IN_PROGRESS);
 
     // save current state in history vectors
-    m_pos_history.push_back(m_interface.get_current_pos());
+    if (!m_compact_history) {
+        m_pos_history.push_back(m_interface.get_current_pos());
+    }
+    m_hash_history.push_back(
+        std::hash<ChessPosition>{}(m_interface.get_current_pos())
+    );
     m_move_history.push_back(move);
 
     // reset half-move clock on captures and pawn moves
@@ -174,8 +211,14 @@ ChessGame::run(ChessEngine *white, ChessEngine *black, bool verbose) {
                 make_move(move);
             }
         } else {
-            const ChessMove move =
-                player->pick_move(m_interface, m_pos_history, m_move_history);
+            static const std::vector<ChessPosition> NO_POS_HISTORY;
+            const ChessMove move = player->pick_move(
+                m_interface,
+                (m_compact_history && !player->needs_pos_history())
+                    ? NO_POS_HISTORY
+                    : get_pos_history(),
+                m_move_history
+            );
             if (verbose) {
                 std::cout << "Chosen move: "
                           << m_interface.get_current_pos().get_move_name(
@@ -1,7 +1,8 @@
 #ifndef SUCKER_CHESS_CHESS_GAME_HPP
 #define SUCKER_CHESS_CHESS_GAME_HPP
 
-#include <cstdint> // for std::uint8_t
+#include <cstddef> // for std::size_t
+#include <cstdint> // for std::uint8_t, std::uint64_t
 #include <string>  // for std::string
 #include <vector>  // for std::vector
 
@@ -26,14 +27,19 @@ class ChessGame final {
 
     ChessEngineInterface m_interface;
     GameStatus m_status;
-    std::vector<ChessPosition> m_pos_history;
+    bool m_compact_history;
+    std::vector<ChessPosition> m_pos_history;  // filled lazily if compact
+    std::vector<std::uint64_t> m_hash_history; // hash of each position
     std::vector<ChessMove> m_move_history;
     int m_half_move_clock;
     int m_full_move_count;
 
 public: // ========================================================= CONSTRUCTOR
 
-    explicit ChessGame() noexcept;
+    // In compact history mode, the game stores only the hash of each
+    // position before each move (alongside the move itself), and rebuilds
+    // positions by replaying moves when they are requested.
+    explicit ChessGame(bool compact_history = false) noexcept;
 
 public: // =========================================================== ACCESSORS
 
@@ -41,11 +47,19 @@ public: // =========================================================== ACCESSORS
         return m_status;
     }
 
-    [[nodiscard]] constexpr const std::vector<ChessPosition> &
-    get_pos_history() const noexcept {
-        return m_pos_history;
+    [[nodiscard]] constexpr bool has_compact_history() const noexcept {
+        return m_compact_history;
     }
 
+    // Returns the position before each move of the game. In compact history
+    // mode, positions that have not been requested before are rebuilt (and
+    // kept for later requests) first.
+    const std::vector<ChessPosition> &get_pos_history() noexcept;
+
+    // Returns the position before the move with the given index, rebuilding
+    // it from the nearest stored position in compact history mode.
+    [[nodiscard]] ChessPosition get_pos(std::size_t index) const noexcept;
+
     [[nodiscard]] constexpr const std::vector<ChessMove> &
     get_move_history() const noexcept {
         return m_move_history;
@@ -3,7 +3,6 @@
 
 #include <algorithm> // for std::max
 #include <cassert>   // for assert
-#include <cmath>     // for std::abs
 #include <compare>   // for operator<=>
 #include <cstdint>   // for std::uint16_t
 #include <ostream>   // for std::ostream
@@ -16,6 +15,12 @@ constexpr coord_t NUM_FILES = 8;
 constexpr coord_t NUM_RANKS = 8;
 
 
+// std::abs is not constexpr until C++23
+[[nodiscard]] constexpr coord_t coord_abs(coord_t x) noexcept {
+    return (x < 0) ? -x : x;
+}
+
+
 struct ChessSquare final {
 
     coord_t file;
@@ -35,7 +40,7 @@ struct ChessSquare final {
 
     [[nodiscard]] constexpr coord_t distance(ChessSquare other) const noexcept {
         return std::max(
-            std::abs(file - other.file), std::abs(rank - other.rank)
+            coord_abs(file - other.file), coord_abs(rank - other.rank)
         );
     }
 
@@ -57,6 +62,10 @@ class ChessMove final {
 
 public: // ======================================================== CONSTRUCTORS
 
+    // Leaves the move uninitialized, so that preallocated arrays of moves
+    // (e.g., in MoveList) can be created without paying to fill them.
+    ChessMove() noexcept = default;
+
 #ifdef SUCKER_CHESS_USE_COMPRESSED_CHESS_MOVE
 
     constexpr ChessMove(ChessSquare source, ChessSquare destination) noexcept
@@ -210,8 +219,8 @@ public: // ============================================================ GEOMETRY
     }
 
     [[nodiscard]] constexpr bool is_diagonal() const noexcept {
-        return std::abs(get_src_file() - get_dst_file()) ==
-               std::abs(get_src_rank() - get_dst_rank());
+        return coord_abs(get_src_file() - get_dst_file()) ==
+               coord_abs(get_src_rank() - get_dst_rank());
     }
 
     [[nodiscard]] constexpr coord_t distance() const noexcept {
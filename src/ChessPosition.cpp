@@ -19,20 +19,14 @@ bool ChessPosition::check_consistency() const noexcept {
     });
 
     std::vector<ChessMove> generated_legal_white_moves;
-    visit_legal_moves(
-        PieceColor::WHITE,
-        [&](ChessMove move, const ChessPosition &) {
-            generated_legal_white_moves.push_back(move);
-        }
-    );
+    visit_legal_moves(PieceColor::WHITE, [&](ChessMove move) {
+        generated_legal_white_moves.push_back(move);
+    });
 
     std::vector<ChessMove> generated_legal_black_moves;
-    visit_legal_moves(
-        PieceColor::BLACK,
-        [&](ChessMove move, const ChessPosition &) {
-            generated_legal_black_moves.push_back(move);
-        }
-    );
+    visit_legal_moves(PieceColor::BLACK, [&](ChessMove move) {
+        generated_legal_black_moves.push_back(move);
+    });
 
     std::vector<ChessMove> filtered_valid_white_moves;
     std::vector<ChessMove> filtered_valid_black_moves;
@@ -129,13 +123,61 @@ bool ChessPosition::check_consistency() const noexcept {
         return false;
     }
 
+    if ((count_legal_moves(PieceColor::WHITE) !=
+         generated_legal_white_moves.size()) ||
+        (count_legal_moves(PieceColor::BLACK) !=
+         generated_legal_black_moves.size())) {
+        return false;
+    }
+
+    const auto same_captures =
+        [&](PieceColor color, const std::vector<ChessMove> &legal_moves) {
+            std::vector<ChessMove> generated;
+            visit_capture_moves(color, [&](ChessMove move) {
+                generated.push_back(move);
+            });
+            std::vector<ChessMove> filtered;
+            for (ChessMove move : legal_moves) {
+                if (is_capture(move) ||
+                    (move.get_promotion_type() != PieceType::NONE)) {
+                    filtered.push_back(move);
+                }
+            }
+            std::sort(generated.begin(), generated.end());
+            return generated == filtered;
+        };
+    if (!same_captures(PieceColor::WHITE, generated_legal_white_moves) ||
+        !same_captures(PieceColor::BLACK, generated_legal_black_moves)) {
+        return false;
+    }
+
+    for (PieceColor color : {PieceColor::WHITE, PieceColor::BLACK}) {
+        bitboard_t attacked = 0;
+        for (coord_t file = 0; file < NUM_FILES; ++file) {
+            for (coord_t rank = 0; rank < NUM_RANKS; ++rank) {
+                if (board.is_attacked_by(color, {file, rank})) {
+                    attacked |= square_bit({file, rank});
+                }
+            }
+        }
+        if (board.attack_map(color) != attacked) { return false; }
+    }
+
+#ifdef SUCKER_CHESS_USE_ZOBRIST_HASH
+    if (hash_key != compute_hash_key()) { return false; }
+#endif
+
+#ifdef SUCKER_CHESS_TRACK_MATERIAL_SCORE
+    if (material_score != compute_material_score()) { return false; }
+#endif
+
     ChessPosition fen_round_trip(get_fen());
     return (*this) == fen_round_trip;
 }
 
 
 std::string ChessPosition::get_move_name(
-    const std::vector<ChessMove> &legal_moves, ChessMove move, bool suffix
+    const MoveList &legal_moves, ChessMove move, bool suffix
 ) const {
     assert(is_valid(move));
     const ChessPiece piece = board.get_piece(move.get_src());
@@ -209,9 +251,7 @@ std::string ChessPosition::get_move_name(
         copy.make_move(move);
         if (copy.in_check()) {
             bool has_legal_moves = false;
-            copy.visit_legal_moves([&](ChessMove, const ChessPosition &) {
-                has_legal_moves = true;
-            });
+            copy.visit_legal_moves([&](ChessMove) { has_legal_moves = true; });
             result << (has_legal_moves ? '+' : '#');
         }
     }
@@ -296,6 +336,14 @@ void ChessPosition::load_fen(const std::string &fen_string) {
         move_data |= 0x08;
         move_data |= static_cast<std::uint8_t>(fen_en_passant_file - 'a');
     }
+
+#ifdef SUCKER_CHESS_USE_ZOBRIST_HASH
+    hash_key = compute_hash_key();
+#endif
+
+#ifdef SUCKER_CHESS_TRACK_MATERIAL_SCORE
+    material_score = compute_material_score();
+#endif
 }
 
 
@@ -322,15 +370,42 @@ std::string ChessPosition::get_fen() const noexcept {
 }
 
 
+#ifndef SUCKER_CHESS_USE_ZOBRIST_HASH
+
 std::size_t std::hash<ChessPosition>::operator()(const ChessPosition &pos
 ) const noexcept {
     // FNV-1a hash algorithm from:
     // https://en.wikipedia.org/wiki/Fowler%E2%80%93Noll%E2%80%93Vo_hash_function#FNV-1a_hash
+    // Each member is hashed separately, since ChessPosition may contain
+    // padding bytes (e.g., when using bitboards) whose values are unspecified.
     std::uint64_t result = UINT64_C(0xcbf29ce484222325);
-    const char *ptr = reinterpret_cast<const char *>(&pos);
-    for (std::size_t i = 0; i < sizeof(ChessPosition); ++i) {
-        result ^= static_cast<std::uint64_t>(ptr[i]);
-        result *= UINT64_C(0x00000100000001b3);
-    }
+    const auto hash_bytes = [&](const auto &member) {
+        const char *ptr = reinterpret_cast<const char *>(&member);
+        for (std::size_t i = 0; i < sizeof(member); ++i) {
+            result ^= static_cast<std::uint64_t>(ptr[i]);
+            result *= UINT64_C(0x00000100000001b3);
+        }
+    };
+#ifdef SUCKER_CHESS_USE_BITBOARDS
+    // the mailbox is redundant with the bitboards, so only hash the latter
+    hash_bytes(pos.board.get_color_bitboard(PieceColor::WHITE));
+    hash_bytes(pos.board.get_color_bitboard(PieceColor::BLACK));
+    hash_bytes(pos.board.get_type_bitboard(PieceType::KING));
+    hash_bytes(pos.board.get_type_bitboard(PieceType::QUEEN));
+    hash_bytes(pos.board.get_type_bitboard(PieceType::ROOK));
+    hash_bytes(pos.board.get_type_bitboard(PieceType::BISHOP));
+    hash_bytes(pos.board.get_type_bitboard(PieceType::KNIGHT));
+    hash_bytes(pos.board.get_type_bitboard(PieceType::PAWN));
+#else
+    hash_bytes(pos.board);
+#endif
+    hash_bytes(pos.move_data);
+    hash_bytes(pos.castling_rights);
+#ifdef SUCKER_CHESS_TRACK_KING_LOCATIONS
+    hash_bytes(pos.white_king_location_data);
+    hash_bytes(pos.black_king_location_data);
+#endif
     return static_cast<std::size_t>(result);
 }
+
+#endif
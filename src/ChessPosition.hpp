@@ -13,6 +13,41 @@
 #include "ChessBoard.hpp"
 #include "ChessMove.hpp"
 #include "ChessPiece.hpp"
+#include "MaterialScore.hpp"
+#include "MoveList.hpp"
+#include "Zobrist.hpp"
+
+
+class ChessPosition;
+
+
+namespace std { // forward declare template specialization for std::hash
+
+template <>
+struct hash<ChessPosition>;
+
+} // namespace std
+
+
+// Everything that make_move overwrites and that cannot be recovered from the
+// move itself, saved so that unmake_move can restore the previous position.
+struct UndoInfo {
+
+    ChessPiece captured_piece = EMPTY_SQUARE; // empty for en passant
+    std::uint8_t move_data = 0;
+    CastlingRights castling_rights = CastlingRights(false, false, false, false);
+#ifdef SUCKER_CHESS_TRACK_KING_LOCATIONS
+    std::uint8_t white_king_location_data = 0;
+    std::uint8_t black_king_location_data = 0;
+#endif
+#ifdef SUCKER_CHESS_USE_ZOBRIST_HASH
+    std::uint64_t hash_key = 0;
+#endif
+#ifdef SUCKER_CHESS_TRACK_MATERIAL_SCORE
+    int material_score = 0;
+#endif
+
+}; // struct UndoInfo
 
 
 class ChessPosition final {
@@ -26,6 +61,16 @@ class ChessPosition final {
     std::uint8_t black_king_location_data;
 #endif
 
+#ifdef SUCKER_CHESS_USE_ZOBRIST_HASH
+    std::uint64_t hash_key; // maintained incrementally by make_move
+#endif
+
+#ifdef SUCKER_CHESS_TRACK_MATERIAL_SCORE
+    int material_score; // maintained incrementally by make_move
+#endif
+
+    friend struct std::hash<ChessPosition>;
+
 public: // ======================================================== CONSTRUCTORS
 
     explicit constexpr ChessPosition() noexcept
@@ -35,8 +80,20 @@ public: // ======================================================== CONSTRUCTORS
 #ifdef SUCKER_CHESS_TRACK_KING_LOCATIONS
         , white_king_location_data(0x40)
         , black_king_location_data(0x47)
+#endif
+#ifdef SUCKER_CHESS_USE_ZOBRIST_HASH
+        , hash_key(0)
+#endif
+#ifdef SUCKER_CHESS_TRACK_MATERIAL_SCORE
+        , material_score(0)
 #endif
     {
+#ifdef SUCKER_CHESS_USE_ZOBRIST_HASH
+        hash_key = compute_hash_key();
+#endif
+#ifdef SUCKER_CHESS_TRACK_MATERIAL_SCORE
+        material_score = compute_material_score();
+#endif
     }
 
     explicit ChessPosition(const std::string &fen)
@@ -46,6 +103,12 @@ public: // ======================================================== CONSTRUCTORS
 #ifdef SUCKER_CHESS_TRACK_KING_LOCATIONS
         , white_king_location_data(0)
         , black_king_location_data(0)
+#endif
+#ifdef SUCKER_CHESS_USE_ZOBRIST_HASH
+        , hash_key(0)
+#endif
+#ifdef SUCKER_CHESS_TRACK_MATERIAL_SCORE
+        , material_score(0)
 #endif
     {
         load_fen(fen);
@@ -153,6 +216,57 @@ public: // ========================================================== COMPARISON
     constexpr bool operator==(const ChessPosition &other
     ) const noexcept = default;
 
+#ifdef SUCKER_CHESS_USE_ZOBRIST_HASH
+
+public: // ============================================================= HASHING
+
+    [[nodiscard]] constexpr std::uint64_t get_hash_key() const noexcept {
+        return hash_key;
+    }
+
+    // Computes the Zobrist hash key of this position from scratch.
+    [[nodiscard]] constexpr std::uint64_t compute_hash_key() const noexcept {
+        std::uint64_t result = 0;
+        for (coord_t file = 0; file < NUM_FILES; ++file) {
+            for (coord_t rank = 0; rank < NUM_RANKS; ++rank) {
+                const ChessSquare square = {file, rank};
+                result ^= zobrist_key(board.get_piece(square), square);
+            }
+        }
+        result ^= zobrist_key(castling_rights);
+        result ^= en_passant_hash_key();
+        if (get_color_to_move() == PieceColor::BLACK) {
+            result ^= ZOBRIST_KEYS.black_to_move;
+        }
+        return result;
+    }
+
+#endif
+
+#ifdef SUCKER_CHESS_TRACK_MATERIAL_SCORE
+
+public: // ====================================================== MATERIAL SCORE
+
+    // Returns the material and piece-square score of this position from
+    // white's point of view (see MaterialScore.hpp).
+    [[nodiscard]] constexpr int get_material_score() const noexcept {
+        return material_score;
+    }
+
+#endif
+
+    // Computes the material score of this position from scratch.
+    [[nodiscard]] constexpr int compute_material_score() const noexcept {
+        int result = 0;
+        for (coord_t file = 0; file < NUM_FILES; ++file) {
+            for (coord_t rank = 0; rank < NUM_RANKS; ++rank) {
+                const ChessSquare square = {file, rank};
+                result += piece_square_score(board.get_piece(square), square);
+            }
+        }
+        return result;
+    }
+
 private: // ===================================================== PAWN UTILITIES
 
     [[nodiscard]] constexpr bool is_en_passant_available() const noexcept {
@@ -170,6 +284,16 @@ private: // ===================================================== PAWN UTILITIES
         __builtin_unreachable();
     }
 
+#ifdef SUCKER_CHESS_USE_ZOBRIST_HASH
+
+    [[nodiscard]] constexpr std::uint64_t en_passant_hash_key() const noexcept {
+        return is_en_passant_available()
+                   ? zobrist_en_passant_key(move_data & 0x07)
+                   : std::uint64_t{0};
+    }
+
+#endif
+
 private: // ============================================ MOVE VALIDATION HELPERS
 
 #define ensure(cond)                                                           \
@@ -429,6 +553,12 @@ public: // ====================================================== MOVE EXECUTION
         const ChessPiece piece = board.get_piece(move.get_src());
         const PieceColor color = piece.get_color();
 
+#ifdef SUCKER_CHESS_USE_ZOBRIST_HASH
+        // remove castling rights and en passant data from hash key;
+        // their updated values are added back at the end of this function
+        hash_key ^= zobrist_key(castling_rights) ^ en_passant_hash_key();
+#endif
+
         // update castling rights
         if (piece == WHITE_KING) {
             castling_rights.disallow_white_short_castle();
@@ -453,6 +583,18 @@ public: // ====================================================== MOVE EXECUTION
 
         // perform move
         if (is_en_passant(move)) {
+#ifdef SUCKER_CHESS_USE_ZOBRIST_HASH
+            hash_key ^= zobrist_key(
+                {!color, PieceType::PAWN},
+                {move.get_dst_file(), move.get_src_rank()}
+            );
+#endif
+#ifdef SUCKER_CHESS_TRACK_MATERIAL_SCORE
+            material_score -= piece_square_score(
+                {!color, PieceType::PAWN},
+                {move.get_dst_file(), move.get_src_rank()}
+            );
+#endif
             board.set_piece(
                 move.get_dst_file(), move.get_src_rank(), EMPTY_SQUARE
             );
@@ -460,19 +602,61 @@ public: // ====================================================== MOVE EXECUTION
             const coord_t rank = move.get_src_rank();
             const ChessPiece rook = {color, PieceType::ROOK};
             if (move.get_dst_file() == 6) { // short castle
+#ifdef SUCKER_CHESS_USE_ZOBRIST_HASH
+                hash_key ^= zobrist_key(rook, {5, rank}) ^
+                            zobrist_key(rook, {7, rank});
+#endif
+#ifdef SUCKER_CHESS_TRACK_MATERIAL_SCORE
+                material_score += piece_square_score(rook, {5, rank}) -
+                                  piece_square_score(rook, {7, rank});
+#endif
                 board.set_piece(5, rank, rook);
                 board.set_piece(7, rank, EMPTY_SQUARE);
             } else if (move.get_dst_file() == 2) { // long castle
+#ifdef SUCKER_CHESS_USE_ZOBRIST_HASH
+                hash_key ^= zobrist_key(rook, {3, rank}) ^
+                            zobrist_key(rook, {0, rank});
+#endif
+#ifdef SUCKER_CHESS_TRACK_MATERIAL_SCORE
+                material_score += piece_square_score(rook, {3, rank}) -
+                                  piece_square_score(rook, {0, rank});
+#endif
                 board.set_piece(3, rank, rook);
                 board.set_piece(0, rank, EMPTY_SQUARE);
             } else {
                 __builtin_unreachable();
             }
         }
+#ifdef SUCKER_CHESS_USE_ZOBRIST_HASH
+        const ChessPiece captured = board.get_piece(move.get_dst());
+        hash_key ^= zobrist_key(piece, move.get_src()) ^
+                    zobrist_key(captured, move.get_dst()) ^
+                    zobrist_key(
+                        piece.promote(move.get_promotion_type()), move.get_dst()
+                    );
+#endif
+#ifdef SUCKER_CHESS_TRACK_MATERIAL_SCORE
+        material_score +=
+            piece_square_score(
+                piece.promote(move.get_promotion_type()), move.get_dst()
+            ) -
+            piece_square_score(piece, move.get_src()) -
+            piece_square_score(board.get_piece(move.get_dst()), move.get_dst());
+#endif
+#ifdef SUCKER_CHESS_USE_BITBOARDS
+        board.remove_piece(move.get_src());
+        if (board.get_piece(move.get_dst()) != EMPTY_SQUARE) {
+            board.remove_piece(move.get_dst());
+        }
+        board.put_piece(
+            move.get_dst(), piece.promote(move.get_promotion_type())
+        );
+#else
         board.set_piece(
             move.get_dst(), piece.promote(move.get_promotion_type())
         );
         board.set_piece(move.get_src(), EMPTY_SQUARE);
+#endif
 
 #ifdef SUCKER_CHESS_TRACK_KING_LOCATIONS
         // update king location
@@ -502,6 +686,89 @@ public: // ====================================================== MOVE EXECUTION
             move_data |= 0x08;
             move_data |= move.get_src_file();
         }
+
+#ifdef SUCKER_CHESS_USE_ZOBRIST_HASH
+        hash_key ^= zobrist_key(castling_rights) ^ en_passant_hash_key() ^
+                    ZOBRIST_KEYS.black_to_move;
+#endif
+    }
+
+    constexpr void make_move(ChessMove move, UndoInfo &undo) noexcept {
+        undo.captured_piece = board.get_piece(move.get_dst());
+        undo.move_data = move_data;
+        undo.castling_rights = castling_rights;
+#ifdef SUCKER_CHESS_TRACK_KING_LOCATIONS
+        undo.white_king_location_data = white_king_location_data;
+        undo.black_king_location_data = black_king_location_data;
+#endif
+#ifdef SUCKER_CHESS_USE_ZOBRIST_HASH
+        undo.hash_key = hash_key;
+#endif
+#ifdef SUCKER_CHESS_TRACK_MATERIAL_SCORE
+        undo.material_score = material_score;
+#endif
+        make_move(move);
+    }
+
+    // Reverts a move made by make_move(move, undo). This must be the most
+    // recent move made on this position.
+    constexpr void unmake_move(ChessMove move, const UndoInfo &undo) noexcept {
+
+        // recover moving piece (which may have been promoted)
+        const ChessPiece moved = board.get_piece(move.get_dst());
+        const PieceColor color = moved.get_color();
+        assert(color != PieceColor::NONE);
+        const ChessPiece piece = (move.get_promotion_type() == PieceType::NONE)
+                                     ? moved
+                                     : ChessPiece{color, PieceType::PAWN};
+
+        // revert move
+#ifdef SUCKER_CHESS_USE_BITBOARDS
+        board.remove_piece(move.get_dst());
+        board.put_piece(move.get_src(), piece);
+        if (undo.captured_piece != EMPTY_SQUARE) {
+            board.put_piece(move.get_dst(), undo.captured_piece);
+        }
+#else
+        board.set_piece(move.get_src(), piece);
+        board.set_piece(move.get_dst(), undo.captured_piece);
+#endif
+        if ((piece.get_type() == PieceType::PAWN) &&
+            (move.get_src_file() != move.get_dst_file()) &&
+            (undo.captured_piece == EMPTY_SQUARE)) { // en passant
+            board.set_piece(
+                move.get_dst_file(),
+                move.get_src_rank(),
+                {!color, PieceType::PAWN}
+            );
+        } else if ((piece.get_type() == PieceType::KING) &&
+                   (move.distance() != 1)) { // castle
+            const coord_t rank = move.get_src_rank();
+            const ChessPiece rook = {color, PieceType::ROOK};
+            if (move.get_dst_file() == 6) { // short castle
+                board.set_piece(7, rank, rook);
+                board.set_piece(5, rank, EMPTY_SQUARE);
+            } else if (move.get_dst_file() == 2) { // long castle
+                board.set_piece(0, rank, rook);
+                board.set_piece(3, rank, EMPTY_SQUARE);
+            } else {
+                __builtin_unreachable();
+            }
+        }
+
+        // restore remaining state
+        move_data = undo.move_data;
+        castling_rights = undo.castling_rights;
+#ifdef SUCKER_CHESS_TRACK_KING_LOCATIONS
+        white_king_location_data = undo.white_king_location_data;
+        black_king_location_data = undo.black_king_location_data;
+#endif
+#ifdef SUCKER_CHESS_USE_ZOBRIST_HASH
+        hash_key = undo.hash_key;
+#endif
+#ifdef SUCKER_CHESS_TRACK_MATERIAL_SCORE
+        material_score = undo.material_score;
+#endif
     }
 
 public: // ======================================================= CHECK TESTING
@@ -568,6 +835,20 @@ private: // ============================================ MOVE GENERATION HELPERS
         }
     }
 
+#ifdef SUCKER_CHESS_USE_BITBOARDS
+
+    template <typename F>
+    constexpr void visit_target_moves(
+        PieceColor moving_color, ChessSquare src, bitboard_t targets, const F &f
+    ) const {
+        visit_squares(
+            targets & ~board.get_color_bitboard(moving_color),
+            [&](ChessSquare dst) { f(ChessMove{src, dst}); }
+        );
+    }
+
+#endif
+
     template <typename F>
     constexpr void visit_promotion_moves(
         PieceColor moving_color, ChessSquare src, ChessSquare dst, const F &f
@@ -684,6 +965,61 @@ private: // ============================================ MOVE GENERATION HELPERS
         }
     }
 
+#ifdef SUCKER_CHESS_USE_BITBOARDS
+
+private: // ====================================== LEGAL MOVE GENERATION HELPERS
+
+    template <typename F>
+    constexpr void visit_legal_king_moves(
+        PieceColor moving_color,
+        ChessSquare src,
+        bitboard_t checkers,
+        const F &f
+    ) const {
+        // The king is removed from the occupancy so that squares further
+        // along the ray of a checking slider are seen as attacked.
+        const bitboard_t occupied = board.get_occupied() & ~square_bit(src);
+        visit_squares(
+            KING_ATTACKS[square_index(src)] &
+                ~board.get_color_bitboard(moving_color),
+            [&](ChessSquare dst) {
+                if (board.attackers_of(!moving_color, dst, occupied) == 0) {
+                    f(ChessMove{src, dst});
+                }
+            }
+        );
+        if (checkers == 0) { visit_castling_moves(moving_color, f); }
+    }
+
+    [[nodiscard]] constexpr bool
+    is_en_passant_target(PieceColor moving_color, ChessMove move
+    ) const noexcept {
+        return is_en_passant_available() &&
+               (moving_color == get_color_to_move()) &&
+               (move.get_dst() == en_passant_square()) &&
+               (move.get_src_file() != move.get_dst_file());
+    }
+
+    // En passant removes two pieces from the same rank, which can expose the
+    // king along that rank even when neither pawn is pinned by itself, and
+    // may capture a checking pawn that is not on the destination square.
+    // Hence, it is tested directly against the resulting occupancy.
+    [[nodiscard]] constexpr bool
+    is_legal_en_passant(PieceColor moving_color, ChessMove move
+    ) const noexcept {
+        const bitboard_t captured =
+            square_bit({move.get_dst_file(), move.get_src_rank()});
+        const bitboard_t occupied =
+            (board.get_occupied() & ~square_bit(move.get_src()) & ~captured) |
+            square_bit(move.get_dst());
+        const bitboard_t attackers = board.attackers_of(
+            !moving_color, get_king_location(moving_color), occupied
+        );
+        return (attackers & ~captured) == 0;
+    }
+
+#endif
+
 public: // ===================================================== MOVE GENERATION
 
     template <typename F>
@@ -694,6 +1030,39 @@ public: // ===================================================== MOVE GENERATION
         const ChessPiece piece = board.get_piece(src);
         assert(piece.get_color() == moving_color);
         assert(piece.get_type() != PieceType::NONE);
+#ifdef SUCKER_CHESS_USE_BITBOARDS
+        const bitboard_t occupied = board.get_occupied();
+        switch (piece.get_type()) {
+            case PieceType::NONE: __builtin_unreachable();
+            case PieceType::KING:
+                visit_target_moves(
+                    moving_color, src, KING_ATTACKS[square_index(src)], f
+                );
+                visit_castling_moves(moving_color, f);
+                break;
+            case PieceType::QUEEN:
+                visit_target_moves(
+                    moving_color, src, queen_attacks(src, occupied), f
+                );
+                break;
+            case PieceType::ROOK:
+                visit_target_moves(
+                    moving_color, src, rook_attacks(src, occupied), f
+                );
+                break;
+            case PieceType::BISHOP:
+                visit_target_moves(
+                    moving_color, src, bishop_attacks(src, occupied), f
+                );
+                break;
+            case PieceType::KNIGHT:
+                visit_target_moves(
+                    moving_color, src, KNIGHT_ATTACKS[square_index(src)], f
+                );
+                break;
+            case PieceType::PAWN: visit_pawn_moves(moving_color, src, f); break;
+        }
+#else
         switch (piece.get_type()) {
             case PieceType::NONE: __builtin_unreachable();
             case PieceType::KING:
@@ -741,11 +1110,18 @@ public: // ===================================================== MOVE GENERATION
                 break;
             case PieceType::PAWN: visit_pawn_moves(moving_color, src, f); break;
         }
+#endif
     }
 
     template <typename F>
     constexpr void
     visit_valid_moves(PieceColor moving_color, const F &f) const {
+#ifdef SUCKER_CHESS_USE_BITBOARDS
+        visit_squares(
+            board.get_color_bitboard(moving_color),
+            [&](ChessSquare src) { visit_valid_moves(moving_color, src, f); }
+        );
+#else
         for (coord_t src_file = 0; src_file < NUM_FILES; ++src_file) {
             for (coord_t src_rank = 0; src_rank < NUM_RANKS; ++src_rank) {
                 const ChessSquare src = {src_file, src_rank};
@@ -754,6 +1130,7 @@ public: // ===================================================== MOVE GENERATION
                 }
             }
         }
+#endif
     }
 
     template <typename F>
@@ -761,6 +1138,144 @@ public: // ===================================================== MOVE GENERATION
         visit_valid_moves(get_color_to_move(), f);
     }
 
+#ifdef SUCKER_CHESS_USE_BITBOARDS
+
+private: // ====================================================== LEGAL TARGETS
+
+    // Legal moves are generated directly, without making each move on a copy
+    // of the position. Checkers and pinned pieces are computed once, after
+    // which every non-king move is restricted to the squares that resolve
+    // check (if any) and to the line of its pin (if any). King moves are
+    // tested against the occupancy with the king removed, so that the king
+    // cannot step backward along the ray of a checking slider.
+    //
+    // For queens, rooks, bishops, and knights, g(src, targets) is called with
+    // the bitboard of legal destination squares, except that it still
+    // includes squares occupied by the moving color. For kings and pawns,
+    // f(move) is called for each legal move.
+    template <typename G, typename F>
+    constexpr void visit_legal_targets(
+        PieceColor moving_color, const G &g, const F &f
+    ) const {
+        const PieceColor enemy = !moving_color;
+        const ChessSquare king = get_king_location(moving_color);
+        const bitboard_t occupied = board.get_occupied();
+        const bitboard_t checkers = board.attackers_of(enemy, king, occupied);
+        const bitboard_t pinned = board.pinned_to(moving_color, king);
+
+        // Kings are never captured. When in check, pieces other than the king
+        // must capture the checker or interpose on its ray. In double check,
+        // only the king may move.
+        bitboard_t evasion_mask = ~board.get_type_bitboard(PieceType::KING);
+        if (checkers != 0) {
+            evasion_mask = (popcount(checkers) == 1)
+                               ? (checkers |
+                                  squares_between(king, first_square(checkers)))
+                               : bitboard_t{0};
+        }
+
+        visit_squares(
+            board.get_color_bitboard(moving_color),
+            [&](ChessSquare src) {
+                const PieceType type = board.get_piece(src).get_type();
+                if (type == PieceType::KING) {
+                    visit_legal_king_moves(moving_color, src, checkers, f);
+                    return;
+                }
+                bitboard_t mask = evasion_mask;
+                if (pinned & square_bit(src)) {
+                    mask &= line_through(king, src);
+                }
+                switch (type) {
+                    case PieceType::NONE: __builtin_unreachable();
+                    case PieceType::KING: __builtin_unreachable();
+                    case PieceType::QUEEN:
+                        g(src, queen_attacks(src, occupied) & mask);
+                        break;
+                    case PieceType::ROOK:
+                        g(src, rook_attacks(src, occupied) & mask);
+                        break;
+                    case PieceType::BISHOP:
+                        g(src, bishop_attacks(src, occupied) & mask);
+                        break;
+                    case PieceType::KNIGHT:
+                        g(src, KNIGHT_ATTACKS[square_index(src)] & mask);
+                        break;
+                    case PieceType::PAWN:
+                        visit_pawn_moves(
+                            moving_color,
+                            src,
+                            [&](ChessMove move) {
+                                if (is_en_passant_target(moving_color, move)) {
+                                    if (is_legal_en_passant(
+                                            moving_color, move
+                                        )) {
+                                        f(move);
+                                    }
+                                } else if (mask & square_bit(move.get_dst())) {
+                                    f(move);
+                                }
+                            }
+                        );
+                        break;
+                }
+            }
+        );
+    }
+
+public: // ========================================================= LEGAL MOVES
+
+    template <typename F>
+    constexpr void
+    visit_legal_moves(PieceColor moving_color, const F &f) const {
+        visit_legal_targets(
+            moving_color,
+            [&](ChessSquare src, bitboard_t targets) {
+                visit_target_moves(moving_color, src, targets, f);
+            },
+            f
+        );
+    }
+
+    // Visits only the legal captures (including en passant) and promotions.
+    // Queen, rook, bishop, and knight targets are restricted to enemy pieces
+    // before any move is built, so quiet moves of those pieces cost nothing.
+    template <typename F>
+    constexpr void
+    visit_capture_moves(PieceColor moving_color, const F &f) const {
+        const bitboard_t enemies = board.get_color_bitboard(!moving_color);
+        visit_legal_targets(
+            moving_color,
+            [&](ChessSquare src, bitboard_t targets) {
+                visit_target_moves(moving_color, src, targets & enemies, f);
+            },
+            [&](ChessMove move) {
+                if (is_capture(move) ||
+                    (move.get_promotion_type() != PieceType::NONE)) {
+                    f(move);
+                }
+            }
+        );
+    }
+
+    // Counts legal moves without visiting them one at a time, using the
+    // population count of each piece's legal target bitboard.
+    [[nodiscard]] constexpr std::size_t
+    count_legal_moves(PieceColor moving_color) const {
+        const bitboard_t own = board.get_color_bitboard(moving_color);
+        std::size_t result = 0;
+        visit_legal_targets(
+            moving_color,
+            [&](ChessSquare, bitboard_t targets) {
+                result += static_cast<std::size_t>(popcount(targets & ~own));
+            },
+            [&](ChessMove) { ++result; }
+        );
+        return result;
+    }
+
+#else
+
     template <typename F>
     constexpr void
     visit_legal_moves(PieceColor moving_color, const F &f) const {
@@ -770,11 +1285,47 @@ public: // ===================================================== MOVE GENERATION
             if (board.get_piece(move.get_dst()).get_type() != PieceType::KING) {
                 ChessPosition next = *this;
                 next.make_move(move);
-                if (!next.in_check(moving_color)) { f(move, next); }
+                if (!next.in_check(moving_color)) { f(move); }
+            }
+        });
+    }
+
+    // Visits only the legal captures (including en passant) and promotions.
+    // Other moves are discarded before they are tested for legality.
+    template <typename F>
+    constexpr void
+    visit_capture_moves(PieceColor moving_color, const F &f) const {
+        visit_valid_moves(moving_color, [&](ChessMove move) {
+            if (!is_capture(move) &&
+                (move.get_promotion_type() == PieceType::NONE)) {
+                return;
+            }
+            if (board.get_piece(move.get_dst()).get_type() != PieceType::KING) {
+                ChessPosition next = *this;
+                next.make_move(move);
+                if (!next.in_check(moving_color)) { f(move); }
             }
         });
     }
 
+    [[nodiscard]] constexpr std::size_t
+    count_legal_moves(PieceColor moving_color) const {
+        std::size_t result = 0;
+        visit_legal_moves(moving_color, [&](ChessMove) { ++result; });
+        return result;
+    }
+
+#endif
+
+    template <typename F>
+    constexpr void visit_capture_moves(const F &f) const {
+        visit_capture_moves(get_color_to_move(), f);
+    }
+
+    [[nodiscard]] constexpr std::size_t count_legal_moves() const {
+        return count_legal_moves(get_color_to_move());
+    }
+
     template <typename F>
     constexpr void visit_legal_moves(const F &f) const {
         visit_legal_moves(get_color_to_move(), f);
@@ -785,9 +1336,7 @@ public: // ===================================================== MOVE GENERATION
 public: // ========================================================= MOVE NAMING
 
     [[nodiscard]] std::string get_move_name(
-        const std::vector<ChessMove> &legal_moves,
-        ChessMove move,
-        bool suffix = true
+        const MoveList &legal_moves, ChessMove move, bool suffix = true
     ) const;
 
 public: // ============================================================= FEN I/O
@@ -807,7 +1356,13 @@ namespace std { // create template specialization for std::hash
 template <>
 struct hash<ChessPosition> {
 
+#ifdef SUCKER_CHESS_USE_ZOBRIST_HASH
+    std::size_t operator()(const ChessPosition &pos) const noexcept {
+        return static_cast<std::size_t>(pos.get_hash_key());
+    }
+#else
     std::size_t operator()(const ChessPosition &pos) const noexcept;
+#endif
 
 }; // struct hash<ChessPosition>
 
@@ -2,11 +2,14 @@
 #include "ChessEngine.hpp"
 #include "Utilities.hpp"
 
-#include <algorithm> // for std::shuffle, std::sort
-#include <climits>   // for INT_MAX
-#include <cstddef>   // for std::size_t
-#include <iomanip>   // for std::left, std::right, std::setw
-#include <iostream>  // for std::cout, std::endl, std::flush
+#include <algorithm>     // for std::shuffle, std::sort
+#include <climits>       // for INT_MAX
+#include <cstddef>       // for std::size_t
+#include <iomanip>       // for std::left, std::right, std::setw
+#include <iostream>      // for std::cout, std::endl, std::flush
+#include <memory>        // for std::unique_ptr
+#include <random>        // for std::mt19937
+#include <vector>        // for std::vector
 
 
 void ChessTournament::add_engine(std::unique_ptr<ChessEngine> &&engine
@@ -48,14 +51,49 @@ void ChessTournament::sort_players_by_win_ratio() {
 }
 
 
-void ChessTournament::run(long long num_rounds, long long print_frequency) {
+void ChessTournament::record_result(
+    Matchup matchup, PieceColor winner, bool verbose
+) {
+    auto &[white_engine, white_info] = engines[matchup.first];
+    auto &[black_engine, black_info] = engines[matchup.second];
+    if (verbose) {
+        std::cout << std::right << std::setw(name_width)
+                  << white_engine->get_name() << " vs. " << std::left
+                  << std::setw(name_width) << black_engine->get_name() << ": ";
+    }
+    switch (winner) {
+        case PieceColor::NONE:
+            if (verbose) { std::cout << "Draw." << std::endl; }
+            ++white_info.num_draws;
+            ++black_info.num_draws;
+            break;
+        case PieceColor::WHITE:
+            if (verbose) {
+                std::cout << white_engine->get_name() << " won!" << std::endl;
+            }
+            ++white_info.num_wins_as_white;
+            ++black_info.num_losses_as_black;
+            break;
+        case PieceColor::BLACK:
+            if (verbose) {
+                std::cout << black_engine->get_name() << " won!" << std::endl;
+            }
+            ++white_info.num_losses_as_white;
+            ++black_info.num_wins_as_black;
+            break;
+    }
+}
+
+
+void ChessTournament::run(
+    long long num_rounds, long long print_frequency, std::size_t num_threads
+) {
 
     const bool infinite_rounds = (num_rounds == -1);
     const bool enable_printing = (print_frequency != -1);
     const bool verbose = (print_frequency == 0);
 
-    // Pairs of player indices; 1st player is white, 2nd player is black
-    std::vector<std::pair<std::size_t, std::size_t>> matchups;
+    std::vector<Matchup> matchups;
     for (std::size_t i = 0; i < engines.size(); ++i) {
         for (std::size_t j = 0; j < engines.size(); ++j) {
             if (i != j) { matchups.emplace_back(i, j); }
@@ -71,45 +109,31 @@ void ChessTournament::run(long long num_rounds, long long print_frequency) {
                       << "..." << std::endl;
         }
 
-        // Randomize all matchups
+        // Randomize all matchups, and draw per-game seeds in a fixed order,
+        // so that results do not depend on which thread plays which game
         std::shuffle(matchups.begin(), matchups.end(), rng);
+        std::vector<std::mt19937::result_type> seeds;
+        for (std::size_t k = 0; k < matchups.size(); ++k) {
+            seeds.push_back(rng());
+        }
 
-        // Play each matchup
-        for (const auto [i, j] : matchups) {
-            auto &[white_engine, white_info] = engines[i];
-            auto &[black_engine, black_info] = engines[j];
-            if (verbose) {
-                std::cout << std::right << std::setw(name_width)
-                          << white_engine->get_name() << " vs. " << std::left
-                          << std::setw(name_width) << black_engine->get_name()
-                          << ": ";
-            }
-            ChessGame game;
-            PieceColor winner =
-                game.run(white_engine.get(), black_engine.get(), false);
-            switch (winner) {
-                case PieceColor::NONE:
-                    if (verbose) { std::cout << "Draw." << std::endl; }
-                    ++white_info.num_draws;
-                    ++black_info.num_draws;
-                    break;
-                case PieceColor::WHITE:
-                    if (verbose) {
-                        std::cout << white_engine->get_name() << " won!"
-                                  << std::endl;
-                    }
-                    ++white_info.num_wins_as_white;
-                    ++black_info.num_losses_as_black;
-                    break;
-                case PieceColor::BLACK:
-                    if (verbose) {
-                        std::cout << black_engine->get_name() << " won!"
-                                  << std::endl;
-                    }
-                    ++white_info.num_losses_as_white;
-                    ++black_info.num_wins_as_black;
-                    break;
-            }
+        // Hand the games out to the threads as they become free. Each game
+        // is played by fresh clones of its engines, seeded from its own seed.
+        std::vector<PieceColor> winners(matchups.size(), PieceColor::NONE);
+        parallel_for(matchups.size(), num_threads, [&](std::size_t k, auto) {
+            const auto [i, j] = matchups[k];
+            std::mt19937 game_rng(seeds[k]);
+            const std::unique_ptr<ChessEngine> white =
+                engines[i].first->clone(split_random_engine(game_rng));
+            const std::unique_ptr<ChessEngine> black =
+                engines[j].first->clone(split_random_engine(game_rng));
+            ChessGame game(true);
+            winners[k] = game.run(white.get(), black.get(), false);
+        });
+
+        // Record results in matchup order
+        for (std::size_t k = 0; k < matchups.size(); ++k) {
+            record_result(matchups[k], winners[k], verbose);
         }
 
         const bool should_print =
@@ -1,6 +1,7 @@
 #ifndef SUCKER_CHESS_CHESS_TOURNAMENT_HPP
 #define SUCKER_CHESS_CHESS_TOURNAMENT_HPP
 
+#include <cstddef> // for std::size_t
 #include <memory>  // for std::unique_ptr
 #include <random>  // for std::mt19937
 #include <string>  // for std::string
@@ -33,6 +34,9 @@ struct PerformanceInfo {
 
 class ChessTournament final {
 
+    // Pair of player indices; 1st player is white, 2nd player is black
+    using Matchup = std::pair<std::size_t, std::size_t>;
+
     std::mt19937 rng;
     std::string name;
     std::vector<std::pair<std::unique_ptr<ChessEngine>, PerformanceInfo>>
@@ -61,18 +65,36 @@ public: // ============================================================ MUTATORS
 
     void sort_players_by_win_ratio();
 
+private: // ========================================================== HELPERS
+
+    /// @brief Add the result of a game to both players' PerformanceInfo
+    void record_result(Matchup matchup, PieceColor winner, bool verbose);
+
 public: // =========================================================== EXECUTION
 
     /**
      * @brief Run a randomized tournament where each round every engine meets
      * every other engine once as white and once as black.
      *
+     * The games of each round are played concurrently on num_threads
+     * threads, each taking the next unplayed matchup as soon as it is free.
+     * Every game is played by fresh clones of its two engines, seeded from a
+     * per-game seed drawn from the tournament RNG before the round starts,
+     * so results are reproducible with SUCKER_CHESS_USE_DETERMINISTIC_SEED
+     * for any number of threads. (UCI engines make their own random choices
+     * and are not covered by this.)
+     *
      * @param num_rounds Number of rounds (-1 for infinite rounds)
      * @param print_frequency Print info about tournament every print_frequency
      * rounds (-1 disables printing, 0 prints each round and gives info about
      * each matchup)
+     * @param num_threads Maximum number of games to play at once
      */
-    void run(long long num_rounds, long long print_frequency = 1);
+    void run(
+        long long num_rounds,
+        long long print_frequency = 1,
+        std::size_t num_threads = 1
+    );
 
     /// @brief Print info about a tournament and its players
     void print_info() const;
@@ -0,0 +1,211 @@
+#ifndef SUCKER_CHESS_ENGINE_MOVE_PICKER_HPP
+#define SUCKER_CHESS_ENGINE_MOVE_PICKER_HPP
+
+#include <algorithm> // for std::min
+#include <array>     // for std::array
+#include <cassert>   // for assert
+#include <cstddef>   // for std::size_t
+#include <utility>   // for std::swap
+
+#include "../Bitboard.hpp"
+#include "../ChessMove.hpp"
+#include "../ChessPiece.hpp"
+#include "../ChessPosition.hpp"
+#include "../MaterialScore.hpp"
+#include "../MoveList.hpp"
+
+
+namespace Engine {
+
+
+// Killer moves and history scores gathered during a search. Both record
+// quiet moves that caused beta cutoffs: killers by the ply at which they
+// did so (since a refutation often works in sibling positions, too), and
+// history by color, source, and destination, weighted by remaining depth.
+class MoveOrdering final {
+
+public: // ===================================================== MEMBER TYPES
+
+    static constexpr std::size_t NUM_KILLERS = 2;
+    static constexpr std::size_t MAX_PLY = 256;
+
+    // history scores never exceed this, so they stay below the bands that
+    // MovePicker reserves for hash moves, captures, and killers
+    static constexpr int MAX_HISTORY = 1'000'000;
+
+private: // ========================================================= MEMBERS
+
+    std::array<std::array<ChessMove, NUM_KILLERS>, MAX_PLY> killers;
+
+    // indexed by [PieceColor - 1][source square index][destination index]
+    std::array<std::array<std::array<int, NUM_SQUARES>, NUM_SQUARES>, 2>
+        history;
+
+public: // ========================================================= CONSTRUCTOR
+
+    explicit MoveOrdering() noexcept
+        : killers()
+        , history() {
+        clear();
+    }
+
+public: // =========================================================== ACCESSORS
+
+    // Returns the index of move among the killers at ply, or NUM_KILLERS if
+    // it is not a killer there.
+    [[nodiscard]] std::size_t killer_index(ChessMove move, int ply
+    ) const noexcept {
+        if ((ply < 0) || (static_cast<std::size_t>(ply) >= MAX_PLY)) {
+            return NUM_KILLERS;
+        }
+        const auto &slots = killers[static_cast<std::size_t>(ply)];
+        for (std::size_t i = 0; i < NUM_KILLERS; ++i) {
+            if (slots[i] == move) { return i; }
+        }
+        return NUM_KILLERS;
+    }
+
+    [[nodiscard]] int history_score(PieceColor color, ChessMove move
+    ) const noexcept {
+        assert(color != PieceColor::NONE);
+        return history[static_cast<std::size_t>(color) - 1]
+                      [square_index(move.get_src())]
+                      [square_index(move.get_dst())];
+    }
+
+public: // ============================================================ MUTATORS
+
+    void clear() noexcept {
+        for (auto &slots : killers) { slots.fill(NULL_MOVE); }
+        for (auto &table : history) {
+            for (auto &row : table) { row.fill(0); }
+        }
+    }
+
+    // Forgets the killers, which belong to the plies of the previous search,
+    // and halves history scores, so that recent cutoffs weigh more.
+    void new_search() noexcept {
+        for (auto &slots : killers) { slots.fill(NULL_MOVE); }
+        for (auto &table : history) {
+            for (auto &row : table) {
+                for (int &score : row) { score /= 2; }
+            }
+        }
+    }
+
+    // Records that the quiet move made by color at ply, with depth plies of
+    // search remaining, caused a beta cutoff.
+    void record_cutoff(PieceColor color, ChessMove move, int ply, int depth
+    ) noexcept {
+        assert(color != PieceColor::NONE);
+        if ((ply >= 0) && (static_cast<std::size_t>(ply) < MAX_PLY)) {
+            auto &slots = killers[static_cast<std::size_t>(ply)];
+            if (slots[0] != move) {
+                for (std::size_t i = NUM_KILLERS - 1; i > 0; --i) {
+                    slots[i] = slots[i - 1];
+                }
+                slots[0] = move;
+            }
+        }
+        int &score = history[static_cast<std::size_t>(color) - 1]
+                            [square_index(move.get_src())]
+                            [square_index(move.get_dst())];
+        score = std::min(score + depth * depth, MAX_HISTORY);
+    }
+
+}; // class MoveOrdering
+
+
+// Yields the legal moves of a position in the order in which an alpha-beta
+// search should try them: the hash move (the best move stored in the
+// transposition table), then captures and promotions, most valuable victim
+// first and least valuable attacker breaking ties (MVV-LVA), then killer
+// moves, then the remaining quiet moves by history score.
+//
+// Each stage occupies its own band of scores, and the next move is found by
+// selecting the highest remaining score. Since a cutoff usually happens
+// within the first few moves, this costs less than sorting the whole list.
+class MovePicker final {
+
+    static constexpr int HASH_MOVE_SCORE = 4'000'000;
+    static constexpr int CAPTURE_SCORE = 3'000'000;
+    static constexpr int KILLER_SCORE = 2'000'000;
+
+    MoveList moves;
+    std::array<int, MoveList::CAPACITY> scores; // only [0, size) initialized
+    std::size_t num_picked;
+
+public: // ========================================================= CONSTRUCTOR
+
+    explicit MovePicker(
+        const ChessPosition &pos,
+        const MoveList &legal_moves,
+        ChessMove hash_move,
+        const MoveOrdering &ordering,
+        int ply
+    ) noexcept
+        : moves(legal_moves)
+        , num_picked(0) {
+        const PieceColor color = pos.get_color_to_move();
+        for (std::size_t i = 0; i < moves.size(); ++i) {
+            const ChessMove move = moves[i];
+            if (move == hash_move) {
+                scores[i] = HASH_MOVE_SCORE;
+            } else if (is_tactical(pos, move)) {
+                scores[i] = CAPTURE_SCORE + mvv_lva(pos, move);
+            } else if (const std::size_t k = ordering.killer_index(move, ply);
+                       k < MoveOrdering::NUM_KILLERS) {
+                scores[i] = KILLER_SCORE - static_cast<int>(k);
+            } else {
+                scores[i] = ordering.history_score(color, move);
+            }
+        }
+    }
+
+public: // ============================================================ PICKING
+
+    // Returns true if move is a capture or a promotion.
+    [[nodiscard]] static constexpr bool
+    is_tactical(const ChessPosition &pos, ChessMove move) noexcept {
+        return pos.is_capture(move) ||
+               (move.get_promotion_type() != PieceType::NONE);
+    }
+
+    // Stores the next move in move and returns true, or returns false if all
+    // moves have been picked.
+    bool next(ChessMove &move) noexcept {
+        if (num_picked >= moves.size()) { return false; }
+        std::size_t best = num_picked;
+        for (std::size_t i = num_picked + 1; i < moves.size(); ++i) {
+            if (scores[i] > scores[best]) { best = i; }
+        }
+        std::swap(moves[num_picked], moves[best]);
+        std::swap(scores[num_picked], scores[best]);
+        move = moves[num_picked];
+        ++num_picked;
+        return true;
+    }
+
+private: // ============================================================ HELPERS
+
+    [[nodiscard]] static constexpr int
+    mvv_lva(const ChessPosition &pos, ChessMove move) noexcept {
+        const ChessBoard &board = pos.get_board();
+        const ChessPiece attacker = board.get_piece(move.get_src());
+        const ChessPiece target = board.get_piece(move.get_dst());
+        int victim_value = unsigned_material_value(move.get_promotion_type());
+        if (target != EMPTY_SQUARE) {
+            victim_value += unsigned_material_value(target.get_type());
+        } else if (pos.is_en_passant(move)) {
+            victim_value += unsigned_material_value(PieceType::PAWN);
+        }
+        return 16 * victim_value - unsigned_material_value(attacker.get_type());
+    }
+
+}; // class MovePicker
+
+
+} // namespace Engine
+
+
+#endif // SUCKER_CHESS_ENGINE_MOVE_PICKER_HPP
@@ -1,40 +1,112 @@
 #include "PreferenceChain.hpp"
 
 #include <cassert> // for assert
+#include <cstddef> // for std::size_t
 #include <memory>  // for std::make_unique
 #include <sstream> // for std::ostringstream
+#include <utility> // for std::move
 
 
+#include "../Bitboard.hpp"
 #include "../Utilities.hpp"
 
 
+SuccessorCache::SuccessorCache() noexcept
+    : m_root(nullptr)
+    , m_moves(nullptr)
+    , m_positions()
+    , m_num_legal_moves()
+    , m_has_position()
+    , m_has_num_legal_moves()
+    , m_has_in_check()
+    , m_in_check() {}
+
+
+void SuccessorCache::reset(const ChessPosition &root, const MoveList &moves) {
+    m_root = &root;
+    m_moves = &moves;
+    m_has_position.clear();
+    m_has_num_legal_moves.clear();
+    m_has_in_check.clear();
+    m_in_check.clear();
+}
+
+
+const ChessPosition &SuccessorCache::get(std::size_t index) {
+    assert(m_root != nullptr);
+    assert(index < m_moves->size());
+    if (!m_has_position.test(index)) {
+        while (m_positions.size() <= index) { m_positions.push_back(*m_root); }
+        m_positions[index] = *m_root;
+        m_positions[index].make_move((*m_moves)[index]);
+        m_has_position.set(index);
+    }
+    return m_positions[index];
+}
+
+
+bool SuccessorCache::gives_check(std::size_t index) {
+    if (!m_has_in_check.test(index)) {
+        if (get(index).in_check()) { m_in_check.set(index); }
+        m_has_in_check.set(index);
+    }
+    return m_in_check.test(index);
+}
+
+
+std::size_t SuccessorCache::count_legal_responses(std::size_t index) {
+    if (!m_has_num_legal_moves.test(index)) {
+        m_num_legal_moves[index] =
+            static_cast<std::uint8_t>(get(index).count_legal_moves());
+        m_has_num_legal_moves.set(index);
+    }
+    return m_num_legal_moves[index];
+}
+
+
 ChessPreference::~ChessPreference() noexcept = default;
 
 
+MoveList ChessPreference::pick_preferred_moves(
+    ChessEngineInterface &interface, const MoveList &allowed_moves
+) {
+    MoveMask allowed = MoveMask::first_n(allowed_moves.size());
+    SuccessorCache successors;
+    successors.reset(interface.get_current_pos(), allowed_moves);
+    narrow_allowed_moves(interface, allowed_moves, successors, allowed);
+    MoveList result;
+    allowed.visit([&](MoveMask::size_type i) {
+        result.push_back(allowed_moves[i]);
+    });
+    return result;
+}
+
+
 namespace Preference {
 
 #define DEFINE_PREFERENCE(NAME)                                                \
-    std::vector<ChessMove> NAME::pick_preferred_moves(                         \
+    void NAME::narrow_allowed_moves(                                           \
         [[maybe_unused]] ChessEngineInterface &interface,                      \
-        const std::vector<ChessMove> &allowed_moves                            \
+        [[maybe_unused]] const MoveList &legal_moves,                          \
+        [[maybe_unused]] SuccessorCache &successors,                           \
+        MoveMask &allowed                                                      \
     )
 
 DEFINE_PREFERENCE(MateInOne) {
-    return maximal_elements(allowed_moves, [&](ChessMove move) {
-        ChessPosition copy = interface.get_current_pos();
-        copy.make_move(move);
-        return interface.checkmated(copy);
+    keep_maximal_elements(legal_moves, allowed, [&](ChessMove, std::size_t i) {
+        return successors.gives_checkmate(i);
     });
 }
 
 DEFINE_PREFERENCE(PreventMateInOne) {
-    return maximal_elements(allowed_moves, [&](ChessMove move) {
-        ChessPosition copy = interface.get_current_pos();
-        copy.make_move(move);
+    keep_maximal_elements(legal_moves, allowed, [&](ChessMove, std::size_t i) {
+        const ChessPosition &next = successors.get(i);
 
         // for each possible opponent response...
-        for (ChessMove move_2 : interface.get_legal_moves(copy)) {
-            ChessPosition copy_2 = copy;
+        // (copied, since checkmated(copy_2) performs another lookup)
+        const MoveList responses = interface.get_legal_moves(next);
+        for (ChessMove move_2 : responses) {
+            ChessPosition copy_2 = next;
             copy_2.make_move(move_2);
 
             // ...ensure that response does not deliver checkmate
@@ -45,24 +117,20 @@ DEFINE_PREFERENCE(PreventMateInOne) {
 }
 
 DEFINE_PREFERENCE(PreventDraw) {
-    return minimal_elements(allowed_moves, [&](ChessMove move) {
-        ChessPosition copy = interface.get_current_pos();
-        copy.make_move(move);
-        return interface.stalemated(copy) ||
-               copy.get_board().has_insufficient_material();
+    keep_minimal_elements(legal_moves, allowed, [&](ChessMove, std::size_t i) {
+        return successors.gives_stalemate(i) ||
+               successors.get(i).get_board().has_insufficient_material();
     });
 }
 
 DEFINE_PREFERENCE(Check) {
-    return maximal_elements(allowed_moves, [&](ChessMove move) {
-        ChessPosition next = interface.get_current_pos();
-        next.make_move(move);
-        return next.in_check();
+    keep_maximal_elements(legal_moves, allowed, [&](ChessMove, std::size_t i) {
+        return successors.gives_check(i);
     });
 }
 
 DEFINE_PREFERENCE(Capture) {
-    return maximal_elements(allowed_moves, [&](ChessMove move) {
+    keep_maximal_elements(legal_moves, allowed, [&](ChessMove move) {
         return interface.get_current_pos().is_capture(move);
     });
 }
@@ -72,7 +140,7 @@ DEFINE_PREFERENCE(CaptureHanging) {
     const PieceColor enemy = !self;
     const ChessPosition &current_pos = interface.get_current_pos();
     const ChessBoard &board = current_pos.get_board();
-    return maximal_elements(allowed_moves, [&](ChessMove move) {
+    keep_maximal_elements(legal_moves, allowed, [&](ChessMove move) {
         return current_pos.is_capture(move) &&
                !board.is_attacked_by(enemy, move.get_dst());
     });
@@ -83,7 +151,7 @@ DEFINE_PREFERENCE(SmartCapture) {
     const PieceColor enemy = !self;
     const ChessPosition &current_pos = interface.get_current_pos();
     const ChessBoard &board = current_pos.get_board();
-    return maximal_elements(allowed_moves, [&](ChessMove move) {
+    keep_maximal_elements(legal_moves, allowed, [&](ChessMove move) {
         if (!current_pos.is_capture(move)) { return 0; }
         int defenders = board.count_attacks_by(self, move.get_dst());
         int attackers = board.count_attacks_by(enemy, move.get_dst());
@@ -94,52 +162,52 @@ DEFINE_PREFERENCE(SmartCapture) {
 DEFINE_PREFERENCE(Castle) {
     const PieceColor self = interface.get_color_to_move();
     const ChessPosition &current_pos = interface.get_current_pos();
-    return maximal_elements(allowed_moves, [&](ChessMove move) {
-        // always castle if possible
-        if (current_pos.is_castle(move)) { return 2; }
-
-        // determine whether this moves gives up castling rights
-        ChessPosition copy = current_pos;
-        copy.make_move(move);
-
-        // avoid giving up short castling rights
-        if (current_pos.can_short_castle(self) &&
-            !copy.can_short_castle(self)) {
-            return 0;
-        }
+    keep_maximal_elements(
+        legal_moves,
+        allowed,
+        [&](ChessMove move, std::size_t i) {
+            // always castle if possible
+            if (current_pos.is_castle(move)) { return 2; }
+
+            // determine whether this moves gives up castling rights
+            const ChessPosition &copy = successors.get(i);
+
+            // avoid giving up short castling rights
+            if (current_pos.can_short_castle(self) &&
+                !copy.can_short_castle(self)) {
+                return 0;
+            }
 
-        // avoid giving up long castling rights
-        if (current_pos.can_long_castle(self) && !copy.can_long_castle(self)) {
-            return 0;
-        }
+            // avoid giving up long castling rights
+            if (current_pos.can_long_castle(self) &&
+                !copy.can_long_castle(self)) {
+                return 0;
+            }
 
-        return 1;
-    });
+            return 1;
+        }
+    );
 }
 
-DEFINE_PREFERENCE(First) { return {*allowed_moves.begin()}; }
+DEFINE_PREFERENCE(First) { allowed.keep_only(allowed.front()); }
 
-DEFINE_PREFERENCE(Last) { return {*allowed_moves.rbegin()}; }
+DEFINE_PREFERENCE(Last) { allowed.keep_only(allowed.back()); }
 
 DEFINE_PREFERENCE(Extend) {
-    return maximal_elements(allowed_moves, [&](ChessMove move) {
-        ChessPosition copy = interface.get_current_pos();
-        copy.make_move(move);
-        return interface.get_legal_moves(copy).size();
+    keep_maximal_elements(legal_moves, allowed, [&](ChessMove, std::size_t i) {
+        return successors.count_legal_responses(i);
     });
 }
 
 DEFINE_PREFERENCE(Reduce) {
-    return minimal_elements(allowed_moves, [&](ChessMove move) {
-        ChessPosition copy = interface.get_current_pos();
-        copy.make_move(move);
-        return interface.get_legal_moves(copy).size();
+    keep_minimal_elements(legal_moves, allowed, [&](ChessMove, std::size_t i) {
+        return successors.count_legal_responses(i);
     });
 }
 
 DEFINE_PREFERENCE(Greedy) {
     const ChessBoard &board = interface.get_current_pos().get_board();
-    return minimal_elements(allowed_moves, [&](ChessMove move) {
+    keep_minimal_elements(legal_moves, allowed, [&](ChessMove move) {
         const ChessPiece target = board.get_piece(move.get_dst());
         if (target == EMPTY_SQUARE) {
             return 7;
@@ -151,7 +219,7 @@ DEFINE_PREFERENCE(Greedy) {
 
 DEFINE_PREFERENCE(Generous) {
     const ChessBoard &board = interface.get_current_pos().get_board();
-    return maximal_elements(allowed_moves, [&](ChessMove move) {
+    keep_maximal_elements(legal_moves, allowed, [&](ChessMove move) {
         const ChessPiece target = board.get_piece(move.get_dst());
         if (target == EMPTY_SQUARE) {
             return 7;
@@ -164,7 +232,7 @@ DEFINE_PREFERENCE(Generous) {
 DEFINE_PREFERENCE(Swarm) {
     const ChessSquare enemy_king_location =
         interface.get_current_pos().get_enemy_king_location();
-    return minimal_elements(allowed_moves, [&](ChessMove move) {
+    keep_minimal_elements(legal_moves, allowed, [&](ChessMove move) {
         return enemy_king_location.distance(move.get_dst()) -
                enemy_king_location.distance(move.get_src());
     });
@@ -173,74 +241,58 @@ DEFINE_PREFERENCE(Swarm) {
 DEFINE_PREFERENCE(Huddle) {
     const ChessSquare king_location =
         interface.get_current_pos().get_king_location();
-    return minimal_elements(allowed_moves, [&](ChessMove move) {
+    keep_minimal_elements(legal_moves, allowed, [&](ChessMove move) {
         return king_location.distance(move.get_dst()) -
                king_location.distance(move.get_src());
     });
 }
 
 DEFINE_PREFERENCE(Sniper) {
-    return maximal_elements(allowed_moves, [&](ChessMove move) {
+    keep_maximal_elements(legal_moves, allowed, [&](ChessMove move) {
         return move.distance();
     });
 }
 
 DEFINE_PREFERENCE(Sloth) {
-    return minimal_elements(allowed_moves, [&](ChessMove move) {
+    keep_minimal_elements(legal_moves, allowed, [&](ChessMove move) {
         return move.distance();
     });
 }
 
 DEFINE_PREFERENCE(Conqueror) {
     const PieceColor self = interface.get_color_to_move();
-    return maximal_elements(allowed_moves, [&](ChessMove move) {
-        ChessPosition copy = interface.get_current_pos();
-        copy.make_move(move);
-        int result = 0;
-        for (coord_t file = 0; file < NUM_FILES; ++file) {
-            for (coord_t rank = 0; rank < NUM_RANKS; ++rank) {
-                ChessSquare square = {file, rank};
-                if (copy.get_board().is_attacked_by(self, square)) { ++result; }
-            }
-        }
-        return result;
+    keep_maximal_elements(legal_moves, allowed, [&](ChessMove, std::size_t i) {
+        return popcount(successors.get(i).get_board().attack_map(self));
     });
 }
 
 DEFINE_PREFERENCE(Constrictor) {
     const PieceColor self = interface.get_color_to_move();
     const PieceColor enemy = !self;
-    return minimal_elements(allowed_moves, [&](ChessMove move) {
-        ChessPosition copy = interface.get_current_pos();
-        copy.make_move(move);
-        int result = 0;
-        for (coord_t file = 0; file < NUM_FILES; ++file) {
-            for (coord_t rank = 0; rank < NUM_RANKS; ++rank) {
-                ChessSquare square = {file, rank};
-                if (copy.get_board().is_attacked_by(enemy, square)) {
-                    ++result;
-                }
-            }
-        }
-        return result;
+    keep_minimal_elements(legal_moves, allowed, [&](ChessMove, std::size_t i) {
+        return popcount(successors.get(i).get_board().attack_map(enemy));
     });
 }
 
 DEFINE_PREFERENCE(Reinforced) {
     const PieceColor self = interface.get_color_to_move();
-    return maximal_elements(allowed_moves, [&](ChessMove move) {
-        ChessPosition copy = interface.get_current_pos();
-        copy.make_move(move);
-        return copy.get_board().is_attacked_by(self, move.get_dst());
-    });
+    keep_maximal_elements(
+        legal_moves,
+        allowed,
+        [&](ChessMove move, std::size_t i) {
+            const ChessPosition &copy = successors.get(i);
+            return copy.get_board().is_attacked_by(self, move.get_dst());
+        }
+    );
 }
 
 DEFINE_PREFERENCE(Outpost) {
     const PieceColor self = interface.get_color_to_move();
     const PieceColor enemy = !self;
     const ChessBoard &board = interface.get_current_pos().get_board();
-    return minimal_elements(allowed_moves, [&](ChessMove move) {
-        return board.is_attacked_by(enemy, move.get_dst());
+    const bitboard_t enemy_attacks = board.attack_map(enemy);
+    keep_minimal_elements(legal_moves, allowed, [&](ChessMove move) {
+        return (enemy_attacks & square_bit(move.get_dst())) != 0;
     });
 }
 
@@ -248,9 +300,10 @@ DEFINE_PREFERENCE(Gambit) {
     const PieceColor self = interface.get_color_to_move();
     const PieceColor enemy = !self;
     const ChessBoard &board = interface.get_current_pos().get_board();
-    return maximal_elements(allowed_moves, [&](ChessMove move) {
-        return board.is_attacked_by(self, move.get_dst()) &&
-               board.is_attacked_by(enemy, move.get_dst());
+    const bitboard_t contested =
+        board.attack_map(self) & board.attack_map(enemy);
+    keep_maximal_elements(legal_moves, allowed, [&](ChessMove move) {
+        return (contested & square_bit(move.get_dst())) != 0;
     });
 }
 
@@ -258,9 +311,9 @@ DEFINE_PREFERENCE(Explore) {
     const PieceColor self = interface.get_color_to_move();
     const PieceColor enemy = !self;
     const ChessBoard &board = interface.get_current_pos().get_board();
-    return minimal_elements(allowed_moves, [&](ChessMove move) {
-        return board.is_attacked_by(self, move.get_dst()) ||
-               board.is_attacked_by(enemy, move.get_dst());
+    const bitboard_t seen = board.attack_map(self) | board.attack_map(enemy);
+    keep_minimal_elements(legal_moves, allowed, [&](ChessMove move) {
+        return (seen & square_bit(move.get_dst())) != 0;
     });
 }
 
@@ -268,8 +321,9 @@ DEFINE_PREFERENCE(Coward) {
     const PieceColor self = interface.get_color_to_move();
     const PieceColor enemy = !self;
     const ChessBoard &board = interface.get_current_pos().get_board();
-    return maximal_elements(allowed_moves, [&](ChessMove move) {
-        return board.is_attacked_by(enemy, move.get_src());
+    const bitboard_t enemy_attacks = board.attack_map(enemy);
+    keep_maximal_elements(legal_moves, allowed, [&](ChessMove move) {
+        return (enemy_attacks & square_bit(move.get_src())) != 0;
     });
 }
 
@@ -277,8 +331,9 @@ DEFINE_PREFERENCE(Hero) {
     const PieceColor self = interface.get_color_to_move();
     const PieceColor enemy = !self;
     const ChessBoard &board = interface.get_current_pos().get_board();
-    return minimal_elements(allowed_moves, [&](ChessMove move) {
-        return board.is_attacked_by(enemy, move.get_src());
+    const bitboard_t enemy_attacks = board.attack_map(enemy);
+    keep_minimal_elements(legal_moves, allowed, [&](ChessMove move) {
+        return (enemy_attacks & square_bit(move.get_src())) != 0;
     });
 }
 
@@ -290,9 +345,21 @@ DEFINE_PREFERENCE(Hero) {
 namespace Engine {
 
 
-PreferenceChain::PreferenceChain(const std::vector<PreferenceToken> &tokens)
-    : rng(properly_seeded_random_engine())
-    , preferences() {
+PreferenceChain::PreferenceChain(
+    const std::vector<PreferenceToken> &preference_tokens
+)
+    : PreferenceChain(preference_tokens, properly_seeded_random_engine()) {}
+
+
+PreferenceChain::PreferenceChain(
+    const std::vector<PreferenceToken> &preference_tokens,
+    std::mt19937 random_engine
+)
+    : rng(std::move(random_engine))
+    , tokens(preference_tokens)
+    , preferences()
+    , name()
+    , successors() {
     std::ostringstream name_builder;
     for (PreferenceToken token : tokens) {
         switch (token) {
@@ -317,16 +384,24 @@ ChessMove PreferenceChain::pick_move(
     [[maybe_unused]] const std::vector<ChessPosition> &pos_history,
     [[maybe_unused]] const std::vector<ChessMove> &move_history
 ) {
-    std::vector<ChessMove> allowed_moves = interface.get_legal_moves();
+    // each preference narrows the same mask over the legal moves in place
+    const MoveList &legal_moves = interface.get_legal_moves();
+    successors.reset(interface.get_current_pos(), legal_moves);
+    MoveMask allowed = MoveMask::first_n(legal_moves.size());
+    std::size_t num_allowed = legal_moves.size();
     for (const std::unique_ptr<ChessPreference> &pref : preferences) {
-        if (allowed_moves.size() <= 1) { break; }
-        allowed_moves = pref->pick_preferred_moves(interface, allowed_moves);
+        if (num_allowed <= 1) { break; }
+        pref->narrow_allowed_moves(interface, legal_moves, successors, allowed);
+        num_allowed = allowed.size();
     }
-    assert(!allowed_moves.empty());
-    if (allowed_moves.size() == 1) {
-        return allowed_moves[0];
+    assert(num_allowed > 0);
+    if (num_allowed == 1) {
+        return legal_moves[allowed.front()];
     } else {
-        return random_choice(rng, allowed_moves);
+        std::uniform_int_distribution<std::size_t> index_dist(
+            0, num_allowed - 1
+        );
+        return legal_moves[allowed.nth(index_dist(rng))];
     }
 }
 
@@ -334,4 +409,10 @@ ChessMove PreferenceChain::pick_move(
 const std::string &PreferenceChain::get_name() noexcept { return name; }
 
 
+std::unique_ptr<ChessEngine>
+PreferenceChain::clone(std::mt19937 random_engine) const {
+    return std::make_unique<PreferenceChain>(tokens, std::move(random_engine));
+}
+
+
 } // namespace Engine
@@ -1,14 +1,62 @@
 #ifndef SUCKER_CHESS_ENGINE_PREFERENCE_CHAIN_HPP
 #define SUCKER_CHESS_ENGINE_PREFERENCE_CHAIN_HPP
 
-#include <memory> // for std::unique_ptr
-#include <random> // for std::mt19937
-#include <string> // for std::string
-#include <vector> // for std::vector
+#include <array>   // for std::array
+#include <cstddef> // for std::size_t
+#include <cstdint> // for std::uint8_t
+#include <memory>  // for std::unique_ptr
+#include <random>  // for std::mt19937
+#include <string>  // for std::string
+#include <vector>  // for std::vector
 
 #include "../ChessEngine.hpp"
 #include "../ChessMove.hpp"
 #include "../ChessPosition.hpp"
+#include "../MoveList.hpp"
+#include "../MoveMask.hpp"
+
+
+// Successors of a position, together with facts derived from them, computed
+// lazily and memoized for the duration of a single decision. A preference
+// chain shares one cache among all of its preferences, so each successor is
+// built at most once per move, no matter how many preferences inspect it.
+class SuccessorCache final {
+
+    const ChessPosition *m_root;
+    const MoveList *m_moves;
+    std::vector<ChessPosition> m_positions; // grows, but never shrinks
+    std::array<std::uint8_t, MoveList::CAPACITY> m_num_legal_moves;
+    MoveMask m_has_position;
+    MoveMask m_has_num_legal_moves;
+    MoveMask m_has_in_check;
+    MoveMask m_in_check;
+
+public:
+
+    explicit SuccessorCache() noexcept;
+
+    // Forgets all cached successors. Subsequent queries refer to the
+    // successors of root by moves, which must both outlive this cache's use.
+    void reset(const ChessPosition &root, const MoveList &moves);
+
+    // Returns the position reached by making moves[index] from root.
+    const ChessPosition &get(std::size_t index);
+
+    // Returns true if moves[index] puts the opponent in check.
+    bool gives_check(std::size_t index);
+
+    // Returns the number of legal responses available to the opponent.
+    std::size_t count_legal_responses(std::size_t index);
+
+    bool gives_checkmate(std::size_t index) {
+        return (count_legal_responses(index) == 0) && gives_check(index);
+    }
+
+    bool gives_stalemate(std::size_t index) {
+        return (count_legal_responses(index) == 0) && !gives_check(index);
+    }
+
+}; // class SuccessorCache
 
 
 class ChessPreference {
@@ -17,11 +65,23 @@ public:
 
     virtual ~ChessPreference() noexcept = 0;
 
-    virtual std::vector<ChessMove> pick_preferred_moves(
+    // Narrows allowed, a set of indices into legal_moves (the legal moves of
+    // the current position of interface), to the moves this preference
+    // prefers. If no allowed move is preferred over any other, allowed is
+    // left unchanged. successors must have been reset to legal_moves.
+    virtual void narrow_allowed_moves(
         ChessEngineInterface &interface,
-        const std::vector<ChessMove> &allowed_moves
+        const MoveList &legal_moves,
+        SuccessorCache &successors,
+        MoveMask &allowed
     ) = 0;
 
+    // Returns the moves in allowed_moves that this preference prefers.
+    // Implemented in terms of narrow_allowed_moves.
+    virtual MoveList pick_preferred_moves(
+        ChessEngineInterface &interface, const MoveList &allowed_moves
+    );
+
 }; // class ChessPreference
 
 
@@ -72,9 +132,11 @@ namespace Preference {
 
 #define CREATE_PREFERENCE_CLASS(CLASS_NAME, TOKEN_NAME, STRING_NAME, COMMENT)  \
     class CLASS_NAME final : public ChessPreference {                          \
-        std::vector<ChessMove> pick_preferred_moves(                           \
+        void narrow_allowed_moves(                                             \
             ChessEngineInterface &interface,                                   \
-            const std::vector<ChessMove> &allowed_moves                        \
+            const MoveList &legal_moves,                                       \
+            SuccessorCache &successors,                                        \
+            MoveMask &allowed                                                  \
         ) override;                                                            \
     };
 
@@ -90,12 +152,21 @@ namespace Engine {
 class PreferenceChain final : public ChessEngine {
 
     std::mt19937 rng;
+    std::vector<PreferenceToken> tokens;
     std::vector<std::unique_ptr<ChessPreference>> preferences;
     std::string name;
+    SuccessorCache successors;
 
 public:
 
-    explicit PreferenceChain(const std::vector<PreferenceToken> &tokens);
+    explicit PreferenceChain(
+        const std::vector<PreferenceToken> &preference_tokens
+    );
+
+    explicit PreferenceChain(
+        const std::vector<PreferenceToken> &preference_tokens,
+        std::mt19937 random_engine
+    );
 
     ChessMove pick_move(
         ChessEngineInterface &interface,
@@ -105,6 +176,9 @@ public:
 
     const std::string &get_name() noexcept override;
 
+    [[nodiscard]] std::unique_ptr<ChessEngine>
+    clone(std::mt19937 random_engine) const override;
+
 }; // class PreferenceChain
 
 } // namespace Engine
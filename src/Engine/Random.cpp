@@ -1,10 +1,16 @@
 #include "Random.hpp"
 
+#include <utility> // for std::move
+
 #include "../Utilities.hpp"
 
 
 Engine::Random::Random() noexcept
-    : rng(properly_seeded_random_engine())
+    : Random(properly_seeded_random_engine()) {}
+
+
+Engine::Random::Random(std::mt19937 random_engine) noexcept
+    : rng(std::move(random_engine))
     , name("Random") {}
 
 
@@ -18,3 +24,9 @@ ChessMove Engine::Random::pick_move(
 
 
 const std::string &Engine::Random::get_name() noexcept { return name; }
+
+
+std::unique_ptr<ChessEngine>
+Engine::Random::clone(std::mt19937 random_engine) const {
+    return std::make_unique<Random>(std::move(random_engine));
+}
@@ -1,6 +1,7 @@
 #ifndef SUCKER_CHESS_ENGINE_RANDOM_HPP
 #define SUCKER_CHESS_ENGINE_RANDOM_HPP
 
+#include <memory> // for std::unique_ptr
 #include <random> // for std::mt19937
 #include <string> // for std::string
 #include <vector> // for std::vector
@@ -20,6 +21,8 @@ public:
 
     explicit Random() noexcept;
 
+    explicit Random(std::mt19937 random_engine) noexcept;
+
     ChessMove pick_move(
         ChessEngineInterface &interface,
         const std::vector<ChessPosition> &pos_history,
@@ -28,6 +31,9 @@ public:
 
     const std::string &get_name() noexcept override;
 
+    [[nodiscard]] std::unique_ptr<ChessEngine>
+    clone(std::mt19937 random_engine) const override;
+
 }; // class Random
 
 
@@ -1,207 +1,512 @@
 #ifndef SUCKER_CHESS_ENGINE_TREE_SEARCH_HPP
 #define SUCKER_CHESS_ENGINE_TREE_SEARCH_HPP
 
-#include <iostream> // TODO: REMOVE
-
-#include <algorithm>     // for std::max, std::min
-#include <limits>        // for std::numeric_limits
-#include <random>        // for std::mt19937
-#include <string>        // for std::string
-#include <unordered_map> // for std::unordered_map
-#include <utility>       // for std::pair, std::make_pair
+#include <algorithm>          // for std::max, std::stable_partition
+#include <atomic>             // for std::atomic, std::memory_order_relaxed
+#include <chrono>             // for std::chrono::steady_clock, milliseconds
+#include <condition_variable> // for std::condition_variable
+#include <cstddef>            // for std::size_t
+#include <cstdint>            // for std::uint64_t
+#include <functional>         // for std::hash
+#include <memory>             // for std::unique_ptr, std::make_unique
+#include <mutex>              // for std::mutex, std::unique_lock
+#include <random>             // for std::mt19937
+#include <string>             // for std::string
+#include <thread>             // for std::thread
+#include <utility>            // for std::move
+#include <vector>             // for std::vector
 
 #include "../ChessEngine.hpp"
+#include "../ChessMove.hpp"
 #include "../ChessPosition.hpp"
+#include "../MoveList.hpp"
+#include "../TranspositionTable.hpp"
 #include "../Utilities.hpp"
+#include "MovePicker.hpp"
 
 
 namespace Engine {
 
 
+// Iterative-deepening negamax search with alpha-beta pruning. Each iteration
+// searches every root move one ply deeper than the last, and the search
+// stops early when its time or node budget runs out, in which case the
+// result of the last completed iteration is used.
+//
+// With more than one thread, the search runs in Lazy SMP fashion: helper
+// threads search the same root alongside the main thread, with every other
+// helper one ply deeper, and share its transposition table. Their results
+// are never used directly. Instead, the entries they store let the main
+// thread cut off or order moves at nodes it has not yet searched itself.
+// The helpers are stopped as soon as the main thread finishes. They live as
+// long as the engine and sleep between searches, so that starting a search
+// costs a wakeup rather than the creation of new threads.
 class TreeSearch final : public ChessEngine {
 
+public: // ===================================================== MEMBER TYPES
+
     using T = int;
-    static constexpr T ONE = static_cast<T>(1);
-    static constexpr T MAX = std::numeric_limits<T>::max();
-    static constexpr T MIN = std::numeric_limits<T>::min();
-    static constexpr T MATE_THRESHOLD = static_cast<T>(1000);
 
-    std::mt19937 rng;
-    std::string name;
-    std::unordered_map<ChessPosition, std::pair<T, int>> evaluation_cache;
+    struct SearchLimits {
+        int max_depth;                      // in plies, counting the root move
+        std::chrono::milliseconds max_time; // per move; zero means unlimited
+        std::uint64_t max_nodes;            // per move; zero means unlimited
+    }; // struct SearchLimits
+
+    static constexpr SearchLimits DEFAULT_LIMITS = {
+        4, std::chrono::milliseconds{0}, 0};
+
+    // Scores are from the point of view of the side to move. A side that
+    // is checkmated after ply half-moves scores -(MATE - ply), so shorter
+    // mates are preferred, and every score lies strictly within +/-INF.
+    static constexpr T MATE = 1'000'000;
+    static constexpr T INF = MATE + 1;
+
+    // no search is deeper than this, so every score above MATE - MAX_PLY
+    // (or below its negation) is a mate score
+    static constexpr int MAX_PLY = 256;
+    static_assert(MAX_PLY == MoveOrdering::MAX_PLY);
+
+    static constexpr std::size_t DEFAULT_TABLE_BYTES = 16 * 1024 * 1024;
+
+private: // ========================================================= MEMBERS
+
+    using clock = std::chrono::steady_clock;
 
-public: // =====================================================================
+    // limits are only checked every NODE_CHECK_INTERVAL nodes,
+    // since reading the clock is much slower than visiting a node
+    static constexpr std::uint64_t NODE_CHECK_INTERVAL = 1024;
 
-    explicit TreeSearch() noexcept
-        : rng(properly_seeded_random_engine())
+    // State of one search thread, aligned so that the node counters of
+    // different threads do not share a cache line.
+    struct alignas(64) SearchThread {
+        MoveOrdering ordering; // persists across moves
+        std::uint64_t nodes;
+        bool stoppable; // false until the first iteration completes,
+                        // except on helpers, which may stop at any time
+        bool stopped;
+    }; // struct SearchThread
+
+    std::mt19937 rng;
+    std::string name;
+    SearchLimits limits;
+    std::size_t table_bytes;
+    TranspositionTable table;          // persists across moves
+    std::vector<SearchThread> threads; // main thread first
+
+    // state of the current search, written only while the helpers are idle
+    clock::time_point deadline;
+    ChessPosition root_pos;
+    MoveList root_legal_moves;
+    int root_depth;
+    std::atomic<bool> main_thread_done;
+
+    // helper thread pool; a search starts when search_id changes
+    std::mutex pool_mutex;
+    std::condition_variable search_started;
+    std::condition_variable search_finished;
+    std::uint64_t search_id;
+    std::size_t num_searching_helpers;
+    bool shutting_down;
+    std::vector<std::thread> helpers; // declared last, so started last
+
+public: // ======================================================== CONSTRUCTORS
+
+    explicit TreeSearch()
+        : TreeSearch(properly_seeded_random_engine()) {}
+
+    explicit TreeSearch(std::mt19937 random_engine)
+        : TreeSearch(DEFAULT_LIMITS, std::move(random_engine)) {}
+
+    explicit TreeSearch(SearchLimits search_limits)
+        : TreeSearch(search_limits, properly_seeded_random_engine()) {}
+
+    // Searches on num_threads threads (the calling thread and
+    // num_threads - 1 helpers), or on one thread if num_threads is zero.
+    // The node limit applies to each thread separately.
+    explicit TreeSearch(
+        SearchLimits search_limits,
+        std::mt19937 random_engine,
+        std::size_t num_threads = 1,
+        std::size_t max_table_bytes = DEFAULT_TABLE_BYTES
+    )
+        : rng(std::move(random_engine))
         , name("TreeSearch")
-        , evaluation_cache() {}
-
-    static constexpr int unsigned_material_value(ChessPiece piece) noexcept {
-        switch (piece.get_type()) {
-            case PieceType::NONE: return 0;
-            case PieceType::KING: return 0;
-            case PieceType::QUEEN: return 900;
-            case PieceType::ROOK: return 500;
-            case PieceType::BISHOP: return 325;
-            case PieceType::KNIGHT: return 300;
-            case PieceType::PAWN: return 100;
+        , limits(clamp_limits(search_limits))
+        , table_bytes(max_table_bytes)
+        , table(max_table_bytes)
+        , threads(std::max(num_threads, std::size_t{1}))
+        , deadline()
+        , root_pos()
+        , root_legal_moves()
+        , root_depth(0)
+        , main_thread_done(false)
+        , pool_mutex()
+        , search_started()
+        , search_finished()
+        , search_id(0)
+        , num_searching_helpers(0)
+        , shutting_down(false)
+        , helpers() {
+        helpers.reserve(threads.size() - 1);
+        for (std::size_t i = 1; i < threads.size(); ++i) {
+            helpers.emplace_back(&TreeSearch::run_helper, this, i);
+        }
+    }
+
+    ~TreeSearch() override {
+        {
+            const std::unique_lock lock(pool_mutex);
+            shutting_down = true;
         }
-        __builtin_unreachable();
+        search_started.notify_all();
+        for (std::thread &helper : helpers) { helper.join(); }
     }
 
+public: // ========================================================= EVALUATION
+
+    // Material and piece-square score from white's point of view. With
+    // SUCKER_CHESS_TRACK_MATERIAL_SCORE, this is maintained by make_move, so
+    // leaf evaluation is O(1) instead of a scan of all 64 squares.
     static constexpr int leaf_evaluation_function(const ChessPosition &pos
     ) noexcept {
-        int result = 0;
-        constexpr int centerness[8] = {0, 3, 5, 10, 10, 5, 3, 0};
-
-        for (coord_t file = 0; file < NUM_FILES; ++file) {
-            for (coord_t rank = 0; rank < NUM_RANKS; ++rank) {
-                ChessPiece piece = pos.get_board().get_piece(file, rank);
-                if (piece.get_type() == PieceType::NONE) { continue; }
-
-                int piece_value = unsigned_material_value(piece);
-                if (piece.get_type() == PieceType::KING) {
-                    piece_value -= centerness[file] + centerness[rank];
-                } else {
-                    piece_value += centerness[file] + centerness[rank];
-                }
+#ifdef SUCKER_CHESS_TRACK_MATERIAL_SCORE
+        return pos.get_material_score();
+#else
+        return pos.compute_material_score();
+#endif
+    }
 
-                switch (piece.get_color()) {
-                    case PieceColor::WHITE: result += piece_value; break;
-                    case PieceColor::BLACK: result -= piece_value; break;
-                    case PieceColor::NONE: __builtin_unreachable();
-                }
-            }
+    // Leaf evaluation from the point of view of the side to move.
+    static constexpr T relative_leaf_evaluation(const ChessPosition &pos
+    ) noexcept {
+        const T value = static_cast<T>(leaf_evaluation_function(pos));
+        return (pos.get_color_to_move() == PieceColor::BLACK) ? -value : value;
+    }
+
+private: // ============================================================= LIMITS
+
+    // Clamps the depth limit to [1, MAX_PLY - 1]. Main search then never
+    // reaches MAX_PLY, even on helpers that search one ply deeper, so mate
+    // scores and killer slots stay within range.
+    static constexpr SearchLimits clamp_limits(SearchLimits search_limits
+    ) noexcept {
+        if (search_limits.max_depth < 1) { search_limits.max_depth = 1; }
+        if (search_limits.max_depth > MAX_PLY - 1) {
+            search_limits.max_depth = MAX_PLY - 1;
         }
-        return result;
+        return search_limits;
     }
 
-    static constexpr T adjust(T value) noexcept {
-        if (value >= MAX - MATE_THRESHOLD) { value -= ONE; }
-        if (value <= MIN + MATE_THRESHOLD) { value += ONE; }
-        return value;
+    // Returns true if thread has run out of time or nodes, or is a helper
+    // whose main thread has finished. Once thread is stoppable, this also
+    // marks it as stopped.
+    bool out_of_budget(SearchThread &thread) noexcept {
+        if (thread.stopped) { return true; }
+        if (!thread.stoppable) { return false; }
+        if (main_thread_done.load(std::memory_order_relaxed)) {
+            thread.stopped = true;
+        } else if ((limits.max_nodes != 0) &&
+                   (thread.nodes >= limits.max_nodes)) {
+            thread.stopped = true;
+        } else if ((limits.max_time.count() != 0) &&
+                   (thread.nodes % NODE_CHECK_INTERVAL == 0) &&
+                   (clock::now() >= deadline)) {
+            thread.stopped = true;
+        }
+        return thread.stopped;
     }
 
-    T evaluate(
-        ChessEngineInterface &interface,
-        const ChessPosition &pos,
-        int depth,
-        T alpha,
-        T beta
-    ) noexcept {
+private: // ================================================ TABLE SCORES
 
-        // Look up current position in interface cache.
-        const PositionInfo &info = interface.lookup(pos);
+    // Mate scores count plies from the root, but a table entry may be reached
+    // from a different root, so they are stored relative to the entry itself.
+    static constexpr T score_to_table(T score, int ply) noexcept {
+        if (score > MATE - MAX_PLY) { return score + ply; }
+        if (score < -(MATE - MAX_PLY)) { return score - ply; }
+        return score;
+    }
 
-        // If there are no legal moves, then the game is over.
-        if (info.legal_moves.empty()) {
-            if (info.in_check) { // checkmate
-                switch (pos.get_color_to_move()) {
-                    case PieceColor::NONE: __builtin_unreachable();
-                    case PieceColor::WHITE: return MIN + ONE;
-                    case PieceColor::BLACK: return MAX - ONE;
-                }
-                __builtin_unreachable();
-            } else { // stalemate
-                return static_cast<T>(0);
-            }
-        }
+    static constexpr T score_from_table(T score, int ply) noexcept {
+        if (score > MATE - MAX_PLY) { return score - ply; }
+        if (score < -(MATE - MAX_PLY)) { return score + ply; }
+        return score;
+    }
 
-        // Otherwise, we need to evaluate the position.
-        if (depth <= 0) { return leaf_evaluation_function(pos); }
+public: // ============================================================= SEARCH
 
-        const auto iter = evaluation_cache.find(pos);
-        if (iter != evaluation_cache.end()) {
-            const auto [prev_eval, prev_depth] = iter->second;
-            if (prev_depth >= depth) { return prev_eval; }
+    // Returns the negamax score of pos, searching only captures and promotions
+    // until the position is quiet, so that the static evaluation is never
+    // taken in the middle of an exchange. The side to move may stand pat on
+    // the static evaluation instead of capturing, except when in check, in
+    // which case every evasion is searched and checkmate is detected.
+    T quiescence(
+        SearchThread &thread, ChessPosition &pos, int ply, T alpha, T beta
+    ) noexcept {
+
+        if (out_of_budget(thread)) { return 0; }
+        ++thread.nodes;
+
+        // Checking evasions are not bounded by depth, so a long enough chain
+        // of checks must be cut off here, before mate scores lose their
+        // meaning and the recursion exhausts the stack.
+        if (ply >= MAX_PLY) { return relative_leaf_evaluation(pos); }
+
+        MoveList moves;
+        T result = -INF;
+        if (pos.in_check()) {
+            pos.visit_legal_moves([&](ChessMove move) {
+                moves.push_back(move);
+            });
+            if (moves.empty()) { return -(MATE - ply); }
+        } else {
+            result = relative_leaf_evaluation(pos);
+            if (result >= beta) { return result; }
+            if (result > alpha) { alpha = result; }
+            pos.visit_capture_moves([&](ChessMove move) {
+                moves.push_back(move);
+            });
         }
 
-        T result;
-        switch (pos.get_color_to_move()) {
+        MovePicker picker(pos, moves, NULL_MOVE, thread.ordering, ply);
+        ChessMove move;
+        while (picker.next(move)) {
+            UndoInfo undo;
+            pos.make_move(move, undo);
+            const T score = -quiescence(thread, pos, ply + 1, -beta, -alpha);
+            pos.unmake_move(move, undo);
+            if (thread.stopped) { return 0; }
+            if (score > result) { result = score; }
+            if (result > alpha) { alpha = result; }
+            if (alpha >= beta) { break; }
+        }
+        return result;
+    }
 
-            case PieceColor::NONE: __builtin_unreachable();
+    // Returns the negamax score of pos, searched depth plies deep, where ply
+    // is the distance from the root. Scores outside (alpha, beta) are bounds.
+    // pos is searched by making and unmaking moves in place, and is restored
+    // to its original state on return. If the search is stopped, the return
+    // value is meaningless and must be discarded.
+    T negamax(
+        SearchThread &thread,
+        ChessPosition &pos,
+        int depth,
+        int ply,
+        T alpha,
+        T beta
+    ) noexcept {
 
-            case PieceColor::WHITE:
-                result = std::numeric_limits<T>::min();
-                for (ChessMove move : info.legal_moves) {
-                    ChessPosition next_pos = pos;
-                    next_pos.make_move(move);
-                    const T next_value = adjust(
-                        evaluate(interface, next_pos, depth - 1, alpha, beta)
-                    );
-                    result = std::max(result, next_value);
-                    if (result > beta) { break; }
-                    alpha = std::max(alpha, result);
+        // At the horizon, only captures and promotions are searched further.
+        if (depth <= 0) { return quiescence(thread, pos, ply, alpha, beta); }
+
+        if (out_of_budget(thread)) { return 0; }
+        ++thread.nodes;
+
+        // A table entry that is deep enough may settle this node outright.
+        // Otherwise, its best move is searched first.
+        const std::uint64_t hash = std::hash<ChessPosition>{}(pos);
+        ChessMove hash_move = NULL_MOVE;
+        TranspositionEntry entry;
+        if (table.probe(hash, entry)) {
+            hash_move = entry.best_move;
+            if (entry.depth >= depth) {
+                const T score = score_from_table(entry.score, ply);
+                if ((entry.bound == Bound::EXACT) ||
+                    ((entry.bound == Bound::LOWER) && (score >= beta)) ||
+                    ((entry.bound == Bound::UPPER) && (score <= alpha))) {
+                    return score;
                 }
-                break;
+            }
+        }
 
-            case PieceColor::BLACK:
-                result = std::numeric_limits<T>::max();
-                for (ChessMove move : info.legal_moves) {
-                    ChessPosition next_pos = pos;
-                    next_pos.make_move(move);
-                    const T next_value = adjust(
-                        evaluate(interface, next_pos, depth - 1, alpha, beta)
+        // Legal moves are generated here rather than looked up through the
+        // ChessEngineInterface, whose cache cannot be shared between threads.
+        MoveList moves;
+        pos.visit_legal_moves([&](ChessMove move) { moves.push_back(move); });
+
+        // If there are no legal moves, then the game is over.
+        if (moves.empty()) { return pos.in_check() ? -(MATE - ply) : 0; }
+
+        MovePicker picker(pos, moves, hash_move, thread.ordering, ply);
+        const T original_alpha = alpha;
+        T result = -INF;
+        ChessMove best_move = NULL_MOVE;
+        ChessMove move;
+        while (picker.next(move)) {
+            UndoInfo undo;
+            pos.make_move(move, undo);
+            const T score =
+                -negamax(thread, pos, depth - 1, ply + 1, -beta, -alpha);
+            pos.unmake_move(move, undo);
+            if (thread.stopped) { return 0; }
+            if (score > result) {
+                result = score;
+                best_move = move;
+            }
+            if (result > alpha) { alpha = result; }
+            if (alpha >= beta) {
+                if (!MovePicker::is_tactical(pos, move)) {
+                    thread.ordering.record_cutoff(
+                        pos.get_color_to_move(), move, ply, depth
                     );
-                    result = std::min(result, next_value);
-                    if (result < alpha) { break; }
-                    beta = std::min(beta, result);
                 }
                 break;
+            }
         }
 
-        evaluation_cache.insert(
-            std::make_pair(pos, std::make_pair(result, depth))
+        // If every move failed low, the best move is not actually known.
+        const Bound bound = (result <= original_alpha) ? Bound::UPPER
+                            : (result >= beta)         ? Bound::LOWER
+                                                       : Bound::EXACT;
+        table.store(
+            hash,
+            {score_to_table(result, ply),
+             (bound == Bound::UPPER) ? NULL_MOVE : best_move,
+             depth,
+             bound}
         );
         return result;
     }
 
+    // Runs iterative deepening from first_depth to last_depth plies on
+    // thread, and returns the best moves found by its last completed
+    // iteration, or no moves if none was completed.
+    std::vector<ChessMove> search_root(
+        SearchThread &thread,
+        ChessPosition pos,
+        MoveList root_moves,
+        int first_depth,
+        int last_depth
+    ) noexcept {
+
+        std::vector<ChessMove> best_moves; // from last completed iteration
+        for (int depth = first_depth; depth <= last_depth; ++depth) {
+
+            // Alpha is carried across root moves, but kept one below the best
+            // score so far, so that moves tying the best are scored exactly
+            // and one of them can be chosen at random.
+            std::vector<ChessMove> candidates;
+            T best = -INF;
+            T alpha = -INF;
+            for (ChessMove move : root_moves) {
+                UndoInfo undo;
+                pos.make_move(move, undo);
+                const T score =
+                    -negamax(thread, pos, depth - 1, 1, -INF, -alpha);
+                pos.unmake_move(move, undo);
+                if (thread.stopped) { break; }
+                if (score > best) {
+                    best = score;
+                    alpha = best - 1;
+                    candidates.clear();
+                    candidates.push_back(move);
+                } else if (score == best) {
+                    candidates.push_back(move);
+                }
+            }
+            if (thread.stopped) { break; }
+            best_moves = std::move(candidates);
+            thread.stoppable = true;
+
+            // search the best moves first in the next iteration
+            std::stable_partition(
+                root_moves.begin(),
+                root_moves.end(),
+                [&](ChessMove move) { return contains(best_moves, move); }
+            );
+        }
+        return best_moves;
+    }
+
     ChessMove pick_move(
         ChessEngineInterface &interface,
         [[maybe_unused]] const std::vector<ChessPosition> &pos_history,
         [[maybe_unused]] const std::vector<ChessMove> &move_history
     ) override {
-        switch (interface.get_color_to_move()) {
-            case PieceColor::NONE: __builtin_unreachable();
-            case PieceColor::WHITE:
-                return random_choice(
-                    rng,
-                    maximal_elements(
-                        interface.get_legal_moves(),
-                        [&](ChessMove move) {
-                            std::cout << "Considering move: " << move;
-                            ChessPosition next = interface.get_current_pos();
-                            next.make_move(move);
-                            const T value =
-                                evaluate(interface, next, 3, MIN, MAX);
-                            std::cout << " : " << value << std::endl;
-                            return value;
-                        }
-                    )
-                );
-            case PieceColor::BLACK:
-                return random_choice(
-                    rng,
-                    minimal_elements(
-                        interface.get_legal_moves(),
-                        [&](ChessMove move) {
-                            std::cout << "Considering move: " << move;
-                            ChessPosition next = interface.get_current_pos();
-                            next.make_move(move);
-                            const T value =
-                                evaluate(interface, next, 3, MIN, MAX);
-                            std::cout << " : " << value << std::endl;
-                            return value;
-                        }
-                    )
-                );
+
+        // The helpers are idle here, so their state can be reset freely.
+        table.new_search();
+        main_thread_done.store(false, std::memory_order_relaxed);
+        for (SearchThread &thread : threads) {
+            thread.ordering.new_search();
+            thread.nodes = 0;
+            thread.stoppable = false;
+            thread.stopped = false;
+        }
+        root_pos = interface.get_current_pos();
+        root_legal_moves = interface.get_legal_moves();
+        root_depth = limits.max_depth;
+        deadline = clock::now() + limits.max_time;
+
+        if (!helpers.empty()) {
+            {
+                const std::unique_lock lock(pool_mutex);
+                num_searching_helpers = helpers.size();
+                ++search_id;
+            }
+            search_started.notify_all();
+        }
+
+        const std::vector<ChessMove> best_moves =
+            search_root(threads[0], root_pos, root_legal_moves, 1, root_depth);
+
+        if (!helpers.empty()) {
+            main_thread_done.store(true, std::memory_order_relaxed);
+            std::unique_lock lock(pool_mutex);
+            search_finished.wait(lock, [&] {
+                return num_searching_helpers == 0;
+            });
         }
-        __builtin_unreachable();
+
+        return random_choice(rng, best_moves);
     }
 
     const std::string &get_name() noexcept override { return name; }
 
+    // The clone has the same search limits and number of threads, and an
+    // empty transposition table of the same size.
+    [[nodiscard]] std::unique_ptr<ChessEngine>
+    clone(std::mt19937 random_engine) const override {
+        return std::make_unique<TreeSearch>(
+            limits, std::move(random_engine), threads.size(), table_bytes
+        );
+    }
+
+private: // ======================================================== THREAD POOL
+
+    // Body of helper thread i. Waits for each search to start, searches the
+    // root until the main thread finishes or its last iteration completes,
+    // and reports back, until the engine is destroyed.
+    void run_helper(std::size_t i) noexcept {
+        SearchThread &thread = threads[i];
+        const int offset = static_cast<int>(i % 2);
+        std::uint64_t last_search_id = 0;
+        while (true) {
+            {
+                std::unique_lock lock(pool_mutex);
+                search_started.wait(lock, [&] {
+                    return shutting_down || (search_id != last_search_id);
+                });
+                if (shutting_down) { return; }
+                last_search_id = search_id;
+            }
+            thread.stoppable = true;
+            search_root(
+                thread,
+                root_pos,
+                root_legal_moves,
+                1 + offset,
+                root_depth + offset
+            );
+            {
+                const std::unique_lock lock(pool_mutex);
+                --num_searching_helpers;
+            }
+            search_finished.notify_one();
+        }
+    }
+
 }; // class TreeSearch
 
 
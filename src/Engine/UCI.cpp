@@ -3,6 +3,7 @@
 #include <cassert>   // for assert
 #include <cctype>    // for std::isspace
 #include <cstring>   // for std::strncmp
+#include <memory>    // for std::make_unique
 #include <sstream>   // for std::ostringstream
 #include <stdexcept> // for std::runtime_error
 #include <utility>   // for std::move
@@ -19,7 +20,8 @@ Engine::UCI::UCI(
     std::size_t engine_n,
     std::string engine_name
 )
-    : pipe(::popen(engine_command.c_str(), "r+"))
+    : command(engine_command)
+    , pipe(::popen(engine_command.c_str(), "r+"))
     , mode(engine_mode)
     , n(engine_n)
     , name(std::move(engine_name)) {
@@ -152,3 +154,9 @@ ChessMove Engine::UCI::pick_move(
 
 
 const std::string &Engine::UCI::get_name() noexcept { return name; }
+
+
+std::unique_ptr<ChessEngine>
+Engine::UCI::clone([[maybe_unused]] std::mt19937 random_engine) const {
+    return std::make_unique<UCI>(command, mode, n, name);
+}
@@ -2,6 +2,8 @@
 #define SUCKER_CHESS_ENGINE_UCI_HPP
 
 #include <cstdio> // for std::FILE
+#include <memory> // for std::unique_ptr
+#include <random> // for std::mt19937
 #include <string> // for std::string
 #include <vector> // for std::vector
 
@@ -19,6 +21,7 @@ public:
 
 private:
 
+    std::string command;
     std::FILE *pipe;
     Mode mode;
     std::size_t n;
@@ -47,6 +50,11 @@ public:
 
     const std::string &get_name() noexcept override;
 
+    // Launches a new process running the same engine command. UCI engines
+    // make their own random choices, so random_engine is unused.
+    [[nodiscard]] std::unique_ptr<ChessEngine>
+    clone(std::mt19937 random_engine) const override;
+
 }; // class UCI
 
 
@@ -22,25 +22,22 @@ Organism::Organism(std::vector<PreferenceToken> _genome) noexcept
     , num_losses(0)
     , genome(std::move(_genome)){};
 
-void Organism::versus(Organism &enemy) {
-    Organism &self = *this;
-    Engine::PreferenceChain white_engine(self.genome);
-    Engine::PreferenceChain black_engine(enemy.genome);
-    ChessGame game;
-
-    switch (game.run(&white_engine, &black_engine, false)) {
-        case PieceColor::NONE:
-            ++self.num_draws;
-            ++enemy.num_draws;
-            break;
-        case PieceColor::WHITE:
-            ++self.num_wins;
-            ++enemy.num_losses;
-            break;
-        case PieceColor::BLACK:
-            ++self.num_losses;
-            ++enemy.num_wins;
-            break;
+PieceColor Organism::versus(
+    const Organism &enemy, std::mt19937 white_rng, std::mt19937 black_rng
+) const {
+    Engine::PreferenceChain white_engine(genome, std::move(white_rng));
+    Engine::PreferenceChain black_engine(enemy.genome, std::move(black_rng));
+    ChessGame game(true);
+    return game.run(&white_engine, &black_engine, false);
+}
+
+void Organism::record_result(PieceColor own_color, PieceColor winner) noexcept {
+    if (winner == PieceColor::NONE) {
+        ++num_draws;
+    } else if (winner == own_color) {
+        ++num_wins;
+    } else {
+        ++num_losses;
     }
 }
 
@@ -73,7 +70,7 @@ enum class MutationToken : std::uint8_t {
 
 void GenePool::mutate(std::vector<PreferenceToken> &genome) noexcept {
     // Create distribution of possible mutations
-    std::discrete_distribution<MutationToken> mutation_dist(
+    std::discrete_distribution<int> mutation_dist(
         {static_cast<double>(genome.size() < PREFERENCE_POOL.size()),
          static_cast<double>(!genome.empty()),
          static_cast<double>(genome.size() > 1),
@@ -83,7 +80,7 @@ void GenePool::mutate(std::vector<PreferenceToken> &genome) noexcept {
     );
 
     // Choose and execute a random mutation
-    const MutationToken token = mutation_dist(rng);
+    const auto token = static_cast<MutationToken>(mutation_dist(rng));
     switch (token) {
         case MutationToken::INSERT:
             random_insert(rng, genome, find_new_gene(genome));
@@ -97,15 +94,53 @@ void GenePool::mutate(std::vector<PreferenceToken> &genome) noexcept {
 }
 
 
-void GenePool::evaluate_fitness(std::size_t num_rounds) noexcept {
-    for (std::size_t i = 0; i < num_rounds; ++i) {
-        for (auto it1 = organisms.begin(); it1 != organisms.end(); ++it1) {
-            for (auto it2 = it1 + 1; it2 != organisms.end(); ++it2) {
-                it1->versus(*it2);
-                it2->versus(*it1);
+void GenePool::evaluate_fitness(
+    std::size_t num_rounds, std::size_t num_threads
+) noexcept {
+
+    struct Game {
+        std::size_t white;
+        std::size_t black;
+        std::mt19937::result_type seed;
+    };
+
+    // Schedule every game up front, drawing per-game seeds in a fixed order
+    // so that results do not depend on which thread plays which game
+    std::vector<Game> games;
+    for (std::size_t round = 0; round < num_rounds; ++round) {
+        for (std::size_t i = 0; i < organisms.size(); ++i) {
+            for (std::size_t j = i + 1; j < organisms.size(); ++j) {
+                games.push_back({i, j, rng()});
+                games.push_back({j, i, rng()});
             }
         }
     }
+
+    // Each thread tallies results into its own copy of the organisms'
+    // counters, so that no two threads ever write to the same organism
+    if (num_threads == 0) { num_threads = 1; }
+    std::vector<std::vector<Organism>> tallies(
+        num_threads, std::vector<Organism>(organisms.size())
+    );
+    parallel_for(games.size(), num_threads, [&](std::size_t k, std::size_t t) {
+        const Game &game = games[k];
+        std::mt19937 game_rng(game.seed);
+        std::mt19937 white_rng = split_random_engine(game_rng);
+        std::mt19937 black_rng = split_random_engine(game_rng);
+        const PieceColor winner = organisms[game.white].versus(
+            organisms[game.black], std::move(white_rng), std::move(black_rng)
+        );
+        tallies[t][game.white].record_result(PieceColor::WHITE, winner);
+        tallies[t][game.black].record_result(PieceColor::BLACK, winner);
+    });
+
+    for (const std::vector<Organism> &tally : tallies) {
+        for (std::size_t i = 0; i < organisms.size(); ++i) {
+            organisms[i].num_wins += tally[i].num_wins;
+            organisms[i].num_draws += tally[i].num_draws;
+            organisms[i].num_losses += tally[i].num_losses;
+        }
+    }
 }
 
 
@@ -6,6 +6,7 @@
 #include <random>  // for std::mt19937
 #include <vector>  // for std::vector
 
+#include "ChessPiece.hpp"
 #include "Engine/PreferenceChain.hpp"
 
 
@@ -21,7 +22,19 @@ public:
     explicit Organism(std::vector<PreferenceToken>) noexcept;
 
     const std::vector<PreferenceToken> &get_genome() const;
-    void versus(Organism &enemy);
+
+    /**
+     * @brief Plays one game as white against enemy, with each side's engine
+     * drawing random numbers from the given random engine
+     *
+     * @return PieceColor Color of the winner (NONE for a draw)
+     */
+    PieceColor versus(
+        const Organism &enemy, std::mt19937 white_rng, std::mt19937 black_rng
+    ) const;
+
+    /// @brief Adds a game result from this organism's perspective
+    void record_result(PieceColor own_color, PieceColor winner) noexcept;
 
 }; // class Organism
 
@@ -90,9 +103,15 @@ public: // =========================================================== EVOLUTION
      * @brief Runs tournament where each round, every organism plays every other
      * organism once as white and once as black
      *
+     * Games are played concurrently. Each game's engines are seeded from the
+     * gene pool's RNG before any game starts, so results are reproducible
+     * with SUCKER_CHESS_USE_DETERMINISTIC_SEED for any number of threads.
+     *
      * @param num_rounds
+     * @param num_threads Maximum number of games to play at once
      */
-    void evaluate_fitness(std::size_t num_rounds) noexcept;
+    void evaluate_fitness(std::size_t num_rounds, std::size_t num_threads = 1)
+        noexcept;
 
     /**
      * @brief Sorts the organisms vector by win-loss-ratio
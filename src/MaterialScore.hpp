@@ -0,0 +1,72 @@
+#ifndef SUCKER_CHESS_MATERIAL_SCORE_HPP
+#define SUCKER_CHESS_MATERIAL_SCORE_HPP
+
+#include <array>   // for std::array
+#include <cstddef> // for std::size_t
+
+#include "Bitboard.hpp"
+#include "ChessPiece.hpp"
+
+
+// The material score of a position is the sum of one piece-square value for
+// each piece on the board, counted positively for white and negatively for
+// black. Each value is the material value of the piece plus a bonus for
+// standing near the center (or, for kings, a penalty). Making a move changes
+// only the values of the pieces it moves, captures, or promotes, so the score
+// can be updated incrementally in constant time.
+
+
+[[nodiscard]] constexpr int unsigned_material_value(PieceType type) noexcept {
+    switch (type) {
+        case PieceType::NONE: return 0;
+        case PieceType::KING: return 0;
+        case PieceType::QUEEN: return 900;
+        case PieceType::ROOK: return 500;
+        case PieceType::BISHOP: return 325;
+        case PieceType::KNIGHT: return 300;
+        case PieceType::PAWN: return 100;
+    }
+    __builtin_unreachable();
+}
+
+
+// indexed by [6 * (PieceColor - 1) + (PieceType - 1)][square_index]
+constexpr std::array<std::array<int, NUM_SQUARES>, 12> MATERIAL_SCORES = []() {
+    constexpr int centerness[8] = {0, 3, 5, 10, 10, 5, 3, 0};
+    constexpr PieceType types[6] = {
+        PieceType::KING,
+        PieceType::QUEEN,
+        PieceType::ROOK,
+        PieceType::BISHOP,
+        PieceType::KNIGHT,
+        PieceType::PAWN};
+    std::array<std::array<int, NUM_SQUARES>, 12> result = {};
+    for (const PieceType type : types) {
+        const std::size_t type_index = static_cast<std::size_t>(type) - 1;
+        for (coord_t file = 0; file < NUM_FILES; ++file) {
+            for (coord_t rank = 0; rank < NUM_RANKS; ++rank) {
+                const int bonus = centerness[file] + centerness[rank];
+                const int value = unsigned_material_value(type) +
+                                  ((type == PieceType::KING) ? -bonus : bonus);
+                const std::size_t index = square_index({file, rank});
+                result[type_index][index] = value;
+                result[6 + type_index][index] = -value;
+            }
+        }
+    }
+    return result;
+}();
+
+
+// Returns the signed contribution of piece on square to the material score.
+[[nodiscard]] constexpr int
+piece_square_score(ChessPiece piece, ChessSquare square) noexcept {
+    if (piece == EMPTY_SQUARE) { return 0; }
+    const std::size_t piece_index =
+        6 * (static_cast<std::size_t>(piece.get_color()) - 1) +
+        (static_cast<std::size_t>(piece.get_type()) - 1);
+    return MATERIAL_SCORES[piece_index][square_index(square)];
+}
+
+
+#endif // SUCKER_CHESS_MATERIAL_SCORE_HPP
@@ -0,0 +1,122 @@
+#ifndef SUCKER_CHESS_MOVE_LIST_HPP
+#define SUCKER_CHESS_MOVE_LIST_HPP
+
+#include <algorithm>        // for std::copy
+#include <array>            // for std::array
+#include <cassert>          // for assert
+#include <cstddef>          // for std::size_t
+#include <initializer_list> // for std::initializer_list
+
+#include "ChessMove.hpp"
+
+
+// Sequence of at most CAPACITY moves, stored inline instead of on the heap.
+// Every legal chess position has fewer than CAPACITY legal moves, so this
+// can hold the full move list of any position. Copying a MoveList only
+// copies the moves it actually contains.
+class MoveList final {
+
+public: // ===================================================== MEMBER TYPES
+
+    using value_type = ChessMove;
+    using size_type = std::size_t;
+    using iterator = ChessMove *;
+    using const_iterator = const ChessMove *;
+
+    static constexpr size_type CAPACITY = 256;
+
+private: // ========================================================= MEMBERS
+
+    size_type m_size;
+    std::array<ChessMove, CAPACITY> m_moves; // only [0, m_size) initialized
+
+public: // ======================================================== CONSTRUCTORS
+
+    constexpr MoveList() noexcept
+        : m_size(0) {}
+
+    constexpr MoveList(std::initializer_list<ChessMove> moves) noexcept
+        : m_size(0) {
+        assign(moves.begin(), moves.end());
+    }
+
+    constexpr MoveList(const MoveList &other) noexcept
+        : m_size(0) {
+        assign(other.begin(), other.end());
+    }
+
+    constexpr MoveList &operator=(const MoveList &other) noexcept {
+        if (this != &other) { assign(other.begin(), other.end()); }
+        return *this;
+    }
+
+public: // =========================================================== ACCESSORS
+
+    [[nodiscard]] constexpr size_type size() const noexcept { return m_size; }
+
+    [[nodiscard]] constexpr bool empty() const noexcept { return m_size == 0; }
+
+    [[nodiscard]] constexpr ChessMove &operator[](size_type index) noexcept {
+        assert(index < m_size);
+        return m_moves[index];
+    }
+
+    [[nodiscard]] constexpr const ChessMove &operator[](size_type index
+    ) const noexcept {
+        assert(index < m_size);
+        return m_moves[index];
+    }
+
+    [[nodiscard]] constexpr const ChessMove &front() const noexcept {
+        assert(m_size > 0);
+        return m_moves[0];
+    }
+
+    [[nodiscard]] constexpr const ChessMove &back() const noexcept {
+        assert(m_size > 0);
+        return m_moves[m_size - 1];
+    }
+
+    [[nodiscard]] constexpr ChessMove *data() noexcept {
+        return m_moves.data();
+    }
+
+    [[nodiscard]] constexpr const ChessMove *data() const noexcept {
+        return m_moves.data();
+    }
+
+public: // =========================================================== ITERATORS
+
+    [[nodiscard]] constexpr iterator begin() noexcept { return data(); }
+
+    [[nodiscard]] constexpr iterator end() noexcept { return data() + m_size; }
+
+    [[nodiscard]] constexpr const_iterator begin() const noexcept {
+        return data();
+    }
+
+    [[nodiscard]] constexpr const_iterator end() const noexcept {
+        return data() + m_size;
+    }
+
+public: // ============================================================ MUTATORS
+
+    constexpr void clear() noexcept { m_size = 0; }
+
+    constexpr void push_back(ChessMove move) noexcept {
+        assert(m_size < CAPACITY);
+        m_moves[m_size++] = move;
+    }
+
+    constexpr void assign(const ChessMove *first, const ChessMove *last
+    ) noexcept {
+        assert(last - first >= 0);
+        assert(static_cast<size_type>(last - first) <= CAPACITY);
+        m_size = static_cast<size_type>(last - first);
+        std::copy(first, last, m_moves.begin());
+    }
+
+}; // class MoveList
+
+
+#endif // SUCKER_CHESS_MOVE_LIST_HPP
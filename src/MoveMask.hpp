@@ -0,0 +1,209 @@
+#ifndef SUCKER_CHESS_MOVE_MASK_HPP
+#define SUCKER_CHESS_MOVE_MASK_HPP
+
+#include <array>       // for std::array
+#include <bit>         // for std::countl_zero, std::countr_zero, std::popcount
+#include <cassert>     // for assert
+#include <cstddef>     // for std::size_t
+#include <cstdint>     // for std::uint64_t
+#include <type_traits> // for std::is_invocable_v
+
+#include "ChessMove.hpp"
+#include "MoveList.hpp"
+
+
+// Set of indices into a MoveList, stored as a fixed-size bitmask. A subset
+// of a move list can be narrowed in place by clearing bits, without copying
+// any moves.
+class MoveMask final {
+
+public: // ===================================================== MEMBER TYPES
+
+    using size_type = std::size_t;
+
+    static constexpr size_type CAPACITY = MoveList::CAPACITY;
+
+private: // ========================================================= MEMBERS
+
+    static constexpr size_type NUM_WORDS = CAPACITY / 64;
+    static_assert(NUM_WORDS * 64 == CAPACITY);
+
+    std::array<std::uint64_t, NUM_WORDS> m_words;
+
+public: // ======================================================== CONSTRUCTORS
+
+    // Constructs an empty mask.
+    constexpr MoveMask() noexcept
+        : m_words() {}
+
+    // Constructs a mask containing every index in [0, n).
+    static constexpr MoveMask first_n(size_type n) noexcept {
+        assert(n <= CAPACITY);
+        MoveMask result;
+        for (size_type i = 0; i < NUM_WORDS; ++i) {
+            if (n >= 64 * (i + 1)) {
+                result.m_words[i] = ~std::uint64_t{0};
+            } else if (n > 64 * i) {
+                result.m_words[i] = (std::uint64_t{1} << (n - 64 * i)) - 1;
+            }
+        }
+        return result;
+    }
+
+public: // =========================================================== ACCESSORS
+
+    [[nodiscard]] constexpr size_type size() const noexcept {
+        size_type result = 0;
+        for (std::uint64_t word : m_words) {
+            result += static_cast<size_type>(std::popcount(word));
+        }
+        return result;
+    }
+
+    [[nodiscard]] constexpr bool empty() const noexcept {
+        for (std::uint64_t word : m_words) {
+            if (word != 0) { return false; }
+        }
+        return true;
+    }
+
+    [[nodiscard]] constexpr bool test(size_type index) const noexcept {
+        assert(index < CAPACITY);
+        return (m_words[index / 64] >> (index % 64)) & 1;
+    }
+
+    // Returns the smallest index in this mask, which must not be empty.
+    [[nodiscard]] constexpr size_type front() const noexcept {
+        for (size_type i = 0; i < NUM_WORDS; ++i) {
+            if (m_words[i] != 0) {
+                return 64 * i +
+                       static_cast<size_type>(std::countr_zero(m_words[i]));
+            }
+        }
+        assert(false);
+        return CAPACITY;
+    }
+
+    // Returns the largest index in this mask, which must not be empty.
+    [[nodiscard]] constexpr size_type back() const noexcept {
+        for (size_type i = NUM_WORDS; i-- > 0;) {
+            if (m_words[i] != 0) {
+                return 64 * i + 63 -
+                       static_cast<size_type>(std::countl_zero(m_words[i]));
+            }
+        }
+        assert(false);
+        return CAPACITY;
+    }
+
+    // Returns the n-th smallest index in this mask (counting from zero).
+    [[nodiscard]] constexpr size_type nth(size_type n) const noexcept {
+        for (size_type i = 0; i < NUM_WORDS; ++i) {
+            std::uint64_t word = m_words[i];
+            const auto count = static_cast<size_type>(std::popcount(word));
+            if (n >= count) {
+                n -= count;
+                continue;
+            }
+            for (; n > 0; --n) { word &= word - 1; }
+            return 64 * i + static_cast<size_type>(std::countr_zero(word));
+        }
+        assert(false);
+        return CAPACITY;
+    }
+
+    // Calls f(index) for each index in this mask, in increasing order.
+    template <typename F>
+    constexpr void visit(const F &f) const {
+        for (size_type i = 0; i < NUM_WORDS; ++i) {
+            for (std::uint64_t word = m_words[i]; word != 0; word &= word - 1) {
+                f(64 * i + static_cast<size_type>(std::countr_zero(word)));
+            }
+        }
+    }
+
+public: // ============================================================ MUTATORS
+
+    constexpr void clear() noexcept { m_words = {}; }
+
+    constexpr void set(size_type index) noexcept {
+        assert(index < CAPACITY);
+        m_words[index / 64] |= std::uint64_t{1} << (index % 64);
+    }
+
+    constexpr void reset(size_type index) noexcept {
+        assert(index < CAPACITY);
+        m_words[index / 64] &= ~(std::uint64_t{1} << (index % 64));
+    }
+
+    // Removes every index except the given one, which must be in this mask.
+    constexpr void keep_only(size_type index) noexcept {
+        assert(test(index));
+        clear();
+        set(index);
+    }
+
+}; // class MoveMask
+
+
+// Returns f(moves[i], i) if f accepts an index, or f(moves[i]) otherwise.
+template <typename F>
+auto call_with_move(const F &f, const MoveList &moves, MoveMask::size_type i) {
+    using size_type = MoveMask::size_type;
+    if constexpr (std::is_invocable_v<const F &, ChessMove, size_type>) {
+        return f(moves[i], i);
+    } else {
+        return f(moves[i]);
+    }
+}
+
+
+// Narrows mask to the indices i in mask at which f(moves[i]) is maximal.
+// Like maximal_elements, but narrows the mask in place instead of building
+// a new container. f may also take i as a second argument.
+template <typename F>
+void keep_maximal_elements(const MoveList &moves, MoveMask &mask, const F &f) {
+    if (mask.empty()) { return; }
+    using S = decltype(call_with_move(f, moves, 0));
+    MoveMask result;
+    S best = {};
+    bool first = true;
+    mask.visit([&](MoveMask::size_type i) {
+        const S score = call_with_move(f, moves, i);
+        if (first || (score > best)) {
+            result.clear();
+            result.set(i);
+            best = score;
+            first = false;
+        } else if (score == best) {
+            result.set(i);
+        }
+    });
+    mask = result;
+}
+
+
+// Narrows mask to the indices i in mask at which f(moves[i]) is minimal.
+template <typename F>
+void keep_minimal_elements(const MoveList &moves, MoveMask &mask, const F &f) {
+    if (mask.empty()) { return; }
+    using S = decltype(call_with_move(f, moves, 0));
+    MoveMask result;
+    S best = {};
+    bool first = true;
+    mask.visit([&](MoveMask::size_type i) {
+        const S score = call_with_move(f, moves, i);
+        if (first || (score < best)) {
+            result.clear();
+            result.set(i);
+            best = score;
+            first = false;
+        } else if (score == best) {
+            result.set(i);
+        }
+    });
+    mask = result;
+}
+
+
+#endif // SUCKER_CHESS_MOVE_MASK_HPP
@@ -0,0 +1,116 @@
+#include "Perft.hpp"
+
+#include <cassert>    // for assert
+#include <functional> // for std::hash
+
+#include "Utilities.hpp"
+
+
+PerftTable::PerftTable(std::size_t max_bytes)
+    : entries()
+    , mask(0) {
+    std::size_t size = 1;
+    while (2 * size * sizeof(Entry) <= max_bytes) { size *= 2; }
+    entries = std::vector<Entry>(size);
+    mask = size - 1;
+}
+
+
+std::size_t PerftTable::index(std::uint64_t hash, int depth) const noexcept {
+    // mix depth into the index so that counts for the same position at
+    // different depths do not evict each other
+    const std::uint64_t mixed =
+        hash ^ (static_cast<std::uint64_t>(depth) * 0x9E3779B97F4A7C15ULL);
+    return static_cast<std::size_t>(mixed) & mask;
+}
+
+
+bool PerftTable::find(
+    std::uint64_t hash, int depth, unsigned long long &count
+) const noexcept {
+    const Entry &entry = entries[index(hash, depth)];
+    const std::uint64_t data = entry.data.load(std::memory_order_relaxed);
+    const std::uint64_t check = entry.check.load(std::memory_order_relaxed);
+    if (((check ^ data) == hash) &&
+        ((data & 0xFF) == static_cast<std::uint64_t>(depth))) {
+        count = data >> 8;
+        return true;
+    }
+    return false;
+}
+
+
+void PerftTable::insert(
+    std::uint64_t hash, int depth, unsigned long long count
+) noexcept {
+    assert((depth >= 0) && (depth < 0x100));
+    assert(count < (1ULL << 56));
+    const std::uint64_t data =
+        (static_cast<std::uint64_t>(count) << 8) |
+        static_cast<std::uint64_t>(depth);
+    Entry &entry = entries[index(hash, depth)];
+    entry.check.store(hash ^ data, std::memory_order_relaxed);
+    entry.data.store(data, std::memory_order_relaxed);
+}
+
+
+unsigned long long perft(const ChessPosition &pos, int depth) {
+    if (depth <= 0) { return 1; }
+    if (depth == 1) { return pos.count_legal_moves(); }
+    unsigned long long result = 0;
+    pos.visit_legal_moves([&](ChessMove move) {
+        ChessPosition next = pos;
+        next.make_move(move);
+        result += perft(next, depth - 1);
+    });
+    return result;
+}
+
+
+unsigned long long
+perft(const ChessPosition &pos, int depth, PerftTable &table) {
+    // positions just above the leaves are cheaper to count than to look up
+    if (depth <= 1) { return perft(pos, depth); }
+    const std::uint64_t hash = std::hash<ChessPosition>{}(pos);
+    unsigned long long result = 0;
+    if (table.find(hash, depth, result)) { return result; }
+    pos.visit_legal_moves([&](ChessMove move) {
+        ChessPosition next = pos;
+        next.make_move(move);
+        result += perft(next, depth - 1, table);
+    });
+    table.insert(hash, depth, result);
+    return result;
+}
+
+
+std::vector<PerftDivideEntry> perft_divide(
+    const ChessPosition &pos,
+    int depth,
+    std::size_t num_threads,
+    PerftTable &table
+) {
+    std::vector<PerftDivideEntry> result;
+    if (depth <= 0) { return result; }
+    pos.visit_legal_moves([&](ChessMove move) {
+        result.push_back({move, 0});
+    });
+    parallel_for(result.size(), num_threads, [&](std::size_t i, auto) {
+        ChessPosition next = pos;
+        next.make_move(result[i].move);
+        result[i].count = perft(next, depth - 1, table);
+    });
+    return result;
+}
+
+
+void print_perft_divide(
+    std::ostream &os, const std::vector<PerftDivideEntry> &divide
+) {
+    unsigned long long total = 0;
+    for (const PerftDivideEntry &entry : divide) {
+        os << entry.move << ": " << entry.count << '\n';
+        total += entry.count;
+    }
+    os << "\nNodes searched: " << total << '\n';
+}
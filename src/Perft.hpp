@@ -0,0 +1,89 @@
+#ifndef SUCKER_CHESS_PERFT_HPP
+#define SUCKER_CHESS_PERFT_HPP
+
+#include <atomic>  // for std::atomic
+#include <cstddef> // for std::size_t
+#include <cstdint> // for std::uint64_t
+#include <ostream> // for std::ostream
+#include <vector>  // for std::vector
+
+#include "ChessMove.hpp"
+#include "ChessPosition.hpp"
+
+
+// Table of previously computed perft counts, keyed by position hash and
+// depth, which may be shared by any number of threads without locking.
+//
+// Each entry is stored as two independent atomic words: the data word
+// (count and depth) and a check word (data XOR hash). A reader only accepts
+// an entry whose check word matches the data word it read, so an entry torn
+// by concurrent writers is simply treated as a miss. Colliding entries are
+// always replaced.
+class PerftTable final {
+
+    struct Entry {
+        std::atomic<std::uint64_t> check;
+        std::atomic<std::uint64_t> data;
+    }; // struct Entry
+
+    std::vector<Entry> entries; // power of two in size
+    std::size_t mask;
+
+public: // ========================================================= CONSTRUCTOR
+
+    // Allocates the largest power-of-two table that fits in max_bytes.
+    explicit PerftTable(std::size_t max_bytes);
+
+public: // ============================================================== ACCESS
+
+    // If a count for (hash, depth) is present in the table, stores it in
+    // count and returns true. Otherwise, returns false.
+    bool find(std::uint64_t hash, int depth, unsigned long long &count)
+        const noexcept;
+
+    void insert(std::uint64_t hash, int depth, unsigned long long count
+    ) noexcept;
+
+private: // ============================================================ HELPERS
+
+    [[nodiscard]] std::size_t index(std::uint64_t hash, int depth)
+        const noexcept;
+
+}; // class PerftTable
+
+
+struct PerftDivideEntry {
+
+    ChessMove move;
+    unsigned long long count;
+
+}; // struct PerftDivideEntry
+
+
+// Counts the leaf nodes of the legal move tree of pos to the given depth.
+// Leaves are counted in bulk with count_legal_moves, without making the
+// moves that lead to them.
+[[nodiscard]] unsigned long long perft(const ChessPosition &pos, int depth);
+
+// Same as perft(pos, depth), but reuses counts of transposed subtrees that
+// are stored in table (and stores newly computed counts there).
+[[nodiscard]] unsigned long long
+perft(const ChessPosition &pos, int depth, PerftTable &table);
+
+// Computes the perft count below each legal move of pos (i.e., at depth - 1
+// after making that move), splitting the root moves across num_threads
+// threads that share a single table. Results are in move generation order.
+[[nodiscard]] std::vector<PerftDivideEntry> perft_divide(
+    const ChessPosition &pos,
+    int depth,
+    std::size_t num_threads,
+    PerftTable &table
+);
+
+// Prints one "move: count" line per root move, followed by the total.
+void print_perft_divide(
+    std::ostream &os, const std::vector<PerftDivideEntry> &divide
+);
+
+
+#endif // SUCKER_CHESS_PERFT_HPP
@@ -0,0 +1,141 @@
+#include "PositionInfoCache.hpp"
+
+#include <algorithm>  // for std::copy
+#include <cassert>    // for assert
+#include <functional> // for std::hash
+#include <utility>    // for std::move
+
+
+PositionInfoCache::PositionInfoCache(std::size_t max_bytes) noexcept
+    : table()
+    , arena()
+    , arena_end(0)
+    , num_used(0)
+    , max_table_size(MIN_TABLE_SIZE) {
+    constexpr std::size_t bytes_per_entry =
+        sizeof(Entry) + ARENA_MOVES_PER_ENTRY * sizeof(ChessMove);
+    while (2 * max_table_size * bytes_per_entry <= max_bytes) {
+        max_table_size *= 2;
+    }
+}
+
+
+std::size_t PositionInfoCache::get_memory_usage() const noexcept {
+    return table.capacity() * sizeof(Entry) +
+           arena.capacity() * sizeof(ChessMove);
+}
+
+
+bool PositionInfoCache::is_live(
+    const Entry &entry, std::uint64_t arena_end, std::size_t arena_size
+) noexcept {
+    // Moves are written to the arena in order, so the moves of this entry
+    // are overwritten once the arena has advanced by a full cycle past them.
+    return (entry.moves_begin != UNUSED) &&
+           (arena_end <= entry.moves_begin + arena_size);
+}
+
+
+bool PositionInfoCache::find(const ChessPosition &pos, PositionInfo &result)
+    const {
+    if (table.empty()) { return false; }
+    const std::uint64_t hash = std::hash<ChessPosition>{}(pos);
+    const std::size_t mask = table.size() - 1;
+    for (std::size_t i = 0; i < PROBE_LIMIT; ++i) {
+        const Entry &entry = table[(hash + i) & mask];
+        if ((entry.hash == hash) && is_live(entry, arena_end, arena.size()) &&
+            (entry.pos == pos)) {
+            const ChessMove *moves =
+                arena.data() + entry.moves_begin % arena.size();
+            result.legal_moves.assign(moves, moves + entry.num_moves);
+            result.in_check = entry.in_check;
+            return true;
+        }
+    }
+    return false;
+}
+
+
+void PositionInfoCache::insert(
+    const ChessPosition &pos, const PositionInfo &info
+) {
+    if ((2 * (num_used + 1) > table.size()) &&
+        (table.size() < max_table_size)) {
+        resize(table.empty() ? MIN_TABLE_SIZE : 2 * table.size());
+    }
+    insert(
+        pos,
+        std::hash<ChessPosition>{}(pos),
+        info.legal_moves.data(),
+        info.legal_moves.size(),
+        info.in_check
+    );
+}
+
+
+void PositionInfoCache::resize(std::size_t new_table_size) {
+    assert(new_table_size > table.size());
+    const std::vector<Entry> old_table = std::move(table);
+    const std::vector<ChessMove> old_arena = std::move(arena);
+    const std::uint64_t old_arena_end = arena_end;
+
+    const ChessMove null_move = {
+        ChessSquare{0, 0},
+        ChessSquare{0, 0}
+    };
+    table.assign(new_table_size, Entry{ChessPosition(), 0, UNUSED, 0, false});
+    arena.assign(new_table_size * ARENA_MOVES_PER_ENTRY, null_move);
+    arena_end = 0;
+    num_used = 0;
+
+    for (const Entry &entry : old_table) {
+        if (is_live(entry, old_arena_end, old_arena.size())) {
+            insert(
+                entry.pos,
+                entry.hash,
+                old_arena.data() + entry.moves_begin % old_arena.size(),
+                entry.num_moves,
+                entry.in_check
+            );
+        }
+    }
+}
+
+
+void PositionInfoCache::insert(
+    const ChessPosition &pos,
+    std::uint64_t hash,
+    const ChessMove *moves,
+    std::size_t num_moves,
+    bool in_check
+) {
+    assert(!table.empty());
+    assert(num_moves <= MAX_LEGAL_MOVES);
+
+    // Use the first free slot in the probe window, if there is one.
+    // Otherwise, replace the oldest entry in the window.
+    const std::size_t mask = table.size() - 1;
+    Entry *slot = nullptr;
+    for (std::size_t i = 0; i < PROBE_LIMIT; ++i) {
+        Entry &entry = table[(hash + i) & mask];
+        if (!is_live(entry, arena_end, arena.size())) {
+            slot = &entry;
+            break;
+        }
+        if ((slot == nullptr) || (entry.moves_begin < slot->moves_begin)) {
+            slot = &entry;
+        }
+    }
+    if (slot->moves_begin == UNUSED) { ++num_used; }
+
+    // Move lists are stored contiguously, so skip to the start of the arena
+    // if this one would otherwise wrap around its end.
+    const std::size_t arena_size = arena.size();
+    const std::size_t offset = arena_end % arena_size;
+    if (offset + num_moves > arena_size) { arena_end += arena_size - offset; }
+    std::copy(moves, moves + num_moves, arena.data() + arena_end % arena_size);
+
+    *slot = Entry{
+        pos, hash, arena_end, static_cast<std::uint8_t>(num_moves), in_check};
+    arena_end += num_moves;
+}
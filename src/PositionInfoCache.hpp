@@ -0,0 +1,89 @@
+#ifndef SUCKER_CHESS_POSITION_INFO_CACHE_HPP
+#define SUCKER_CHESS_POSITION_INFO_CACHE_HPP
+
+#include <cstddef> // for std::size_t
+#include <cstdint> // for std::uint64_t, std::uint8_t
+#include <vector>  // for std::vector
+
+#include "ChessMove.hpp"
+#include "ChessPosition.hpp"
+#include "MoveList.hpp"
+
+
+struct PositionInfo {
+
+    MoveList legal_moves;
+    bool in_check;
+
+}; // struct PositionInfo
+
+
+// Bounded cache of PositionInfo records, stored in a flat open-addressing
+// hash table whose size is a power of two. Move lists are not stored in the
+// table itself, but in a single ring buffer (the arena) shared by all entries.
+//
+// Memory is allocated lazily: the table starts small and doubles whenever it
+// becomes half full, up to the largest size that fits in the byte budget.
+// Past that point, new entries replace old ones. An entry is evicted either
+// when its probe window is full and it is the oldest entry there, or when
+// its move list is overwritten by the arena wrapping around.
+class PositionInfoCache final {
+
+    struct Entry {
+        ChessPosition pos;
+        std::uint64_t hash;
+        std::uint64_t moves_begin; // arena index (not wrapped); UNUSED if empty
+        std::uint8_t num_moves;
+        bool in_check;
+    }; // struct Entry
+
+    static constexpr std::uint64_t UNUSED = ~std::uint64_t{0};
+    static constexpr std::size_t PROBE_LIMIT = 4;
+    static constexpr std::size_t MIN_TABLE_SIZE = 1024;
+    static constexpr std::size_t ARENA_MOVES_PER_ENTRY = 32;
+    static constexpr std::size_t MAX_LEGAL_MOVES = 255;
+
+    std::vector<Entry> table; // empty or a power of two in size
+    std::vector<ChessMove> arena;
+    std::uint64_t arena_end; // total number of moves ever written to the arena
+    std::size_t num_used;
+    std::size_t max_table_size;
+
+public: // ========================================================= CONSTRUCTOR
+
+    explicit PositionInfoCache(std::size_t max_bytes) noexcept;
+
+public: // ============================================================ CAPACITY
+
+    [[nodiscard]] std::size_t get_memory_usage() const noexcept;
+
+public: // ============================================================== ACCESS
+
+    // If pos is present in the cache, copies its info into result and returns
+    // true. Otherwise, returns false and leaves result unchanged.
+    bool find(const ChessPosition &pos, PositionInfo &result) const;
+
+    void insert(const ChessPosition &pos, const PositionInfo &info);
+
+private: // ============================================================ HELPERS
+
+    // An entry is live if it is in use and its move list has not since been
+    // overwritten by the arena wrapping around.
+    [[nodiscard]] static bool is_live(
+        const Entry &entry, std::uint64_t arena_end, std::size_t arena_size
+    ) noexcept;
+
+    void resize(std::size_t new_table_size);
+
+    void insert(
+        const ChessPosition &pos,
+        std::uint64_t hash,
+        const ChessMove *moves,
+        std::size_t num_moves,
+        bool in_check
+    );
+
+}; // class PositionInfoCache
+
+
+#endif // SUCKER_CHESS_POSITION_INFO_CACHE_HPP
@@ -0,0 +1,156 @@
+#include "TranspositionTable.hpp"
+
+#include <algorithm> // for std::clamp
+#include <atomic>    // for std::memory_order_relaxed
+#include <cassert>   // for assert
+#include <cstdint>   // for std::uint32_t, std::uint64_t
+
+#include "Bitboard.hpp"
+
+
+// layout of the data word of a slot
+static constexpr unsigned MOVE_SHIFT = 32;
+static constexpr unsigned DEPTH_SHIFT = 48;
+static constexpr unsigned BOUND_SHIFT = 56;
+static constexpr unsigned GENERATION_SHIFT = 58;
+static constexpr std::uint64_t GENERATION_MASK = 0x3F;
+
+
+TranspositionTable::TranspositionTable(std::size_t max_bytes)
+    : buckets()
+    , mask(0)
+    , generation(0) {
+    std::size_t size = 1;
+    while (2 * size * sizeof(Bucket) <= max_bytes) { size *= 2; }
+    buckets = std::vector<Bucket>(size);
+    mask = size - 1;
+}
+
+
+std::uint64_t
+TranspositionTable::read(const Slot &slot, std::uint64_t hash) noexcept {
+    const std::uint64_t data = slot.data.load(std::memory_order_relaxed);
+    const std::uint64_t check = slot.check.load(std::memory_order_relaxed);
+    return ((check ^ data) == hash) ? data : 0;
+}
+
+
+void TranspositionTable::write(
+    Slot &slot, std::uint64_t hash, std::uint64_t data
+) noexcept {
+    slot.check.store(hash ^ data, std::memory_order_relaxed);
+    slot.data.store(data, std::memory_order_relaxed);
+}
+
+
+std::uint64_t TranspositionTable::pack(
+    const TranspositionEntry &entry, std::uint8_t entry_generation
+) noexcept {
+    const ChessMove move = entry.best_move;
+    const std::uint64_t packed_move =
+        (static_cast<std::uint64_t>(square_index(move.get_src())) << 9) |
+        (static_cast<std::uint64_t>(square_index(move.get_dst())) << 3) |
+        static_cast<std::uint64_t>(move.get_promotion_type());
+    const auto depth =
+        static_cast<std::uint64_t>(std::clamp(entry.depth, 0, 0xFF));
+    const auto score =
+        static_cast<std::uint64_t>(static_cast<std::uint32_t>(entry.score));
+    return score | (packed_move << MOVE_SHIFT) | (depth << DEPTH_SHIFT) |
+           (static_cast<std::uint64_t>(entry.bound) << BOUND_SHIFT) |
+           (static_cast<std::uint64_t>(entry_generation) << GENERATION_SHIFT);
+}
+
+
+TranspositionEntry TranspositionTable::unpack(std::uint64_t data) noexcept {
+    const auto packed_move = static_cast<std::size_t>(data >> MOVE_SHIFT);
+    const ChessMove move(
+        square_at_index((packed_move >> 9) & 0x3F),
+        square_at_index((packed_move >> 3) & 0x3F),
+        static_cast<PieceType>(packed_move & 0x07)
+    );
+    return {
+        static_cast<int>(static_cast<std::uint32_t>(data)),
+        move,
+        depth_of(data),
+        static_cast<Bound>((data >> BOUND_SHIFT) & 0x03)};
+}
+
+
+int TranspositionTable::depth_of(std::uint64_t data) noexcept {
+    return static_cast<int>((data >> DEPTH_SHIFT) & 0xFF);
+}
+
+
+std::uint8_t TranspositionTable::generation_of(std::uint64_t data) noexcept {
+    return static_cast<std::uint8_t>(data >> GENERATION_SHIFT);
+}
+
+
+bool TranspositionTable::probe(
+    std::uint64_t hash, TranspositionEntry &entry
+) const noexcept {
+    const Bucket &bucket = buckets[static_cast<std::size_t>(hash) & mask];
+    for (const Slot &slot : bucket.slots) {
+        if (const std::uint64_t data = read(slot, hash); data != 0) {
+            entry = unpack(data);
+            return true;
+        }
+    }
+    return false;
+}
+
+
+void TranspositionTable::store(
+    std::uint64_t hash, const TranspositionEntry &entry
+) noexcept {
+    assert(entry.bound != Bound::NONE);
+    Bucket &bucket = buckets[static_cast<std::size_t>(hash) & mask];
+
+    // if this position is already stored, update it in place, unless the
+    // stored result is deeper and from this search, or the new one is exact
+    for (Slot &slot : bucket.slots) {
+        if (const std::uint64_t data = read(slot, hash); data != 0) {
+            if ((entry.bound == Bound::EXACT) ||
+                (entry.depth >= depth_of(data)) ||
+                (generation_of(data) != generation)) {
+                TranspositionEntry updated = entry;
+                if (updated.best_move == NULL_MOVE) {
+                    updated.best_move = unpack(data).best_move;
+                }
+                write(slot, hash, pack(updated, generation));
+            }
+            return;
+        }
+    }
+
+    // otherwise, replace the least valuable depth-preferred slot, where empty
+    // and stale slots are worth less than any slot from the current search
+    std::size_t victim = 0;
+    int victim_value = 0x100;
+    for (std::size_t i = 0; i < ALWAYS_REPLACE_SLOT; ++i) {
+        const std::uint64_t data =
+            bucket.slots[i].data.load(std::memory_order_relaxed);
+        const int value = ((data == 0) || (generation_of(data) != generation))
+                              ? -1
+                              : depth_of(data);
+        if (value < victim_value) {
+            victim = i;
+            victim_value = value;
+        }
+    }
+    if (victim_value > entry.depth) { victim = ALWAYS_REPLACE_SLOT; }
+    write(bucket.slots[victim], hash, pack(entry, generation));
+}
+
+
+void TranspositionTable::new_search() noexcept {
+    generation = static_cast<std::uint8_t>((generation + 1) & GENERATION_MASK);
+}
+
+
+void TranspositionTable::clear() noexcept {
+    for (Bucket &bucket : buckets) {
+        for (Slot &slot : bucket.slots) { write(slot, 0, 0); }
+    }
+    generation = 0;
+}
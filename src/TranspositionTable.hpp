@@ -0,0 +1,113 @@
+#ifndef SUCKER_CHESS_TRANSPOSITION_TABLE_HPP
+#define SUCKER_CHESS_TRANSPOSITION_TABLE_HPP
+
+#include <array>   // for std::array
+#include <atomic>  // for std::atomic
+#include <cstddef> // for std::size_t
+#include <cstdint> // for std::uint8_t, std::uint64_t
+#include <vector>  // for std::vector
+
+#include "ChessMove.hpp"
+
+
+// Kind of score stored in a transposition table entry. An alpha-beta search
+// only learns the exact score of a node whose score falls inside its window;
+// otherwise, it learns a bound (LOWER after a beta cutoff, UPPER if every
+// move failed low).
+enum class Bound : std::uint8_t { NONE, EXACT, LOWER, UPPER };
+
+
+struct TranspositionEntry {
+
+    int score;
+    ChessMove best_move; // NULL_MOVE if unknown
+    int depth;
+    Bound bound;
+
+}; // struct TranspositionEntry
+
+
+// Fixed-size table of search results, keyed by 64-bit position hash.
+//
+// Entries are grouped into buckets of four that fill one 64-byte cache line,
+// so a probe touches a single line. A position may be stored in any slot of
+// the bucket its hash selects. The first three slots are depth-preferred: a
+// new result replaces the shallowest of them, unless all three hold deeper
+// results from the current search, in which case it goes to the fourth slot,
+// which is always replaced. Results from earlier searches (as marked by
+// new_search) are replaced first, so the table does not fill up with stale
+// deep entries over a long game.
+//
+// The table may be shared by any number of threads without locking. As in
+// PerftTable, each slot is stored as two independent atomic words: the data
+// word and a check word (data XOR hash). A reader only accepts a slot whose
+// check word matches the data word it read, so a slot torn by concurrent
+// writers is simply treated as a miss. Concurrent stores to one bucket may
+// lose an update, which only costs the search some work.
+class TranspositionTable final {
+
+    // The data word packs score, move, depth, bound, and generation, and is
+    // zero if the slot is empty.
+    struct Slot {
+        std::atomic<std::uint64_t> check; // data XOR hash
+        std::atomic<std::uint64_t> data;
+    }; // struct Slot
+
+    static constexpr std::size_t SLOTS_PER_BUCKET = 4;
+    static constexpr std::size_t ALWAYS_REPLACE_SLOT = SLOTS_PER_BUCKET - 1;
+
+    struct alignas(64) Bucket {
+        std::array<Slot, SLOTS_PER_BUCKET> slots;
+    }; // struct Bucket
+
+    static_assert(sizeof(Bucket) == 64);
+
+    std::vector<Bucket> buckets; // power of two in size
+    std::size_t mask;
+    std::uint8_t generation; // only changed while no search is running
+
+public: // ========================================================= CONSTRUCTOR
+
+    // Allocates the largest power-of-two table that fits in max_bytes.
+    explicit TranspositionTable(std::size_t max_bytes);
+
+public: // ============================================================== ACCESS
+
+    // If an entry for hash is present in the table, stores it in entry and
+    // returns true. Otherwise, returns false.
+    bool probe(std::uint64_t hash, TranspositionEntry &entry) const noexcept;
+
+    void store(std::uint64_t hash, const TranspositionEntry &entry) noexcept;
+
+    // Marks all current entries as belonging to an earlier search. Must not
+    // be called while another thread is using the table.
+    void new_search() noexcept;
+
+    // Must not be called while another thread is using the table.
+    void clear() noexcept;
+
+private: // ============================================================ HELPERS
+
+    // Returns the data word of slot if it holds an entry for hash, or zero.
+    [[nodiscard]] static std::uint64_t
+    read(const Slot &slot, std::uint64_t hash) noexcept;
+
+    static void write(Slot &slot, std::uint64_t hash, std::uint64_t data
+    ) noexcept;
+
+    [[nodiscard]] static std::uint64_t pack(
+        const TranspositionEntry &entry, std::uint8_t entry_generation
+    ) noexcept;
+
+    [[nodiscard]] static TranspositionEntry unpack(std::uint64_t data
+    ) noexcept;
+
+    [[nodiscard]] static int depth_of(std::uint64_t data) noexcept;
+
+    [[nodiscard]] static std::uint8_t generation_of(std::uint64_t data
+    ) noexcept;
+
+}; // class TranspositionTable
+
+
+#endif // SUCKER_CHESS_TRANSPOSITION_TABLE_HPP
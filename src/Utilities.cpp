@@ -43,6 +43,14 @@ std::mt19937 properly_seeded_random_engine() {
 }
 
 
+std::mt19937 split_random_engine(std::mt19937 &parent) {
+    std::mt19937::result_type seed_data[8];
+    std::generate(std::begin(seed_data), std::end(seed_data), std::ref(parent));
+    std::seed_seq seed(std::begin(seed_data), std::end(seed_data));
+    return std::mt19937(seed);
+}
+
+
 std::string get_ymd_date(char sep) {
     std::ostringstream date;
     std::time_t time = std::time(nullptr);
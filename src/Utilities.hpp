@@ -2,18 +2,25 @@
 #define SUCKER_CHESS_UTILITIES_HPP
 
 #include <array>   // for std::array
+#include <atomic>  // for std::atomic
 #include <cassert> // for assert
 #include <cstddef> // for std::size_t
 #include <ostream> // for std::ostream
 #include <random>  // for std::mt19937, std::uniform_int_distribution
 #include <string>  // for std::string
+#include <thread>  // for std::thread
 #include <utility> // for std::swap
 #include <vector>  // for std::vector
 
 
-template <typename T>
-constexpr bool contains(const std::vector<T> &vec, const T &x) {
-    for (const T &y : vec) {
+// The container helpers below accept any sequence container with
+// vector-like size(), operator[], clear(), and push_back() members,
+// including both std::vector and MoveList.
+
+
+template <typename C, typename T>
+constexpr bool contains(const C &container, const T &x) {
+    for (const auto &y : container) {
         if (x == y) { return true; }
     }
     return false;
@@ -45,12 +52,14 @@ const T &random_choice(std::mt19937 &rng, const std::array<T, N> &arr) {
 }
 
 
-template <typename T>
-const T &random_choice(std::mt19937 &rng, const std::vector<T> &vec) {
-    assert(!vec.empty());
-    std::uniform_int_distribution<typename std::vector<T>::size_type>
-        index_dist(0, vec.size() - 1);
-    return vec[index_dist(rng)];
+template <typename C>
+const typename C::value_type &
+random_choice(std::mt19937 &rng, const C &container) {
+    assert(!container.empty());
+    std::uniform_int_distribution<typename C::size_type> index_dist(
+        0, container.size() - 1
+    );
+    return container[index_dist(rng)];
 }
 
 
@@ -106,21 +115,21 @@ void random_swap(std::mt19937 &rng, std::vector<T> &vec) {
 }
 
 
-template <typename T, typename F>
-std::vector<T> maximal_elements(const std::vector<T> &vec, const F &f) {
-    std::vector<T> result;
-    if (vec.empty()) { return result; }
-    using S = decltype(f(vec[0]));
-    result.push_back(vec[0]);
-    S best = f(vec[0]);
-    for (typename std::vector<T>::size_type i = 1; i < vec.size(); ++i) {
-        const S score = f(vec[i]);
+template <typename C, typename F>
+C maximal_elements(const C &container, const F &f) {
+    C result;
+    if (container.empty()) { return result; }
+    using S = decltype(f(container[0]));
+    result.push_back(container[0]);
+    S best = f(container[0]);
+    for (typename C::size_type i = 1; i < container.size(); ++i) {
+        const S score = f(container[i]);
         if (score > best) {
             result.clear();
-            result.push_back(vec[i]);
+            result.push_back(container[i]);
             best = score;
         } else if (score == best) {
-            result.push_back(vec[i]);
+            result.push_back(container[i]);
         }
     }
     assert(!result.empty());
@@ -128,21 +137,21 @@ std::vector<T> maximal_elements(const std::vector<T> &vec, const F &f) {
 }
 
 
-template <typename T, typename F>
-std::vector<T> minimal_elements(const std::vector<T> &vec, const F &f) {
-    std::vector<T> result;
-    if (vec.empty()) { return result; }
-    using S = decltype(f(vec[0]));
-    result.push_back(vec[0]);
-    S best = f(vec[0]);
-    for (typename std::vector<T>::size_type i = 1; i < vec.size(); ++i) {
-        const S score = f(vec[i]);
+template <typename C, typename F>
+C minimal_elements(const C &container, const F &f) {
+    C result;
+    if (container.empty()) { return result; }
+    using S = decltype(f(container[0]));
+    result.push_back(container[0]);
+    S best = f(container[0]);
+    for (typename C::size_type i = 1; i < container.size(); ++i) {
+        const S score = f(container[i]);
         if (score < best) {
             result.clear();
-            result.push_back(vec[i]);
+            result.push_back(container[i]);
             best = score;
         } else if (score == best) {
-            result.push_back(vec[i]);
+            result.push_back(container[i]);
         }
     }
     assert(!result.empty());
@@ -150,12 +159,47 @@ std::vector<T> minimal_elements(const std::vector<T> &vec, const F &f) {
 }
 
 
+// Calls f(i, thread_index) for each i in [0, n) on up to num_threads threads
+// (including the calling thread), and returns once every call has finished.
+// Indices are handed out dynamically, so f must not depend on which thread
+// runs it; thread_index lets f write to per-thread storage without locking.
+template <typename F>
+void parallel_for(std::size_t n, std::size_t num_threads, const F &f) {
+    if (num_threads > n) { num_threads = n; }
+    if (num_threads <= 1) {
+        for (std::size_t i = 0; i < n; ++i) { f(i, std::size_t{0}); }
+        return;
+    }
+    std::atomic<std::size_t> next_index = 0;
+    const auto work = [&](std::size_t thread_index) {
+        while (true) {
+            const std::size_t i = next_index.fetch_add(1);
+            if (i >= n) { return; }
+            f(i, thread_index);
+        }
+    };
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads - 1);
+    for (std::size_t t = 1; t < num_threads; ++t) {
+        threads.emplace_back(work, t);
+    }
+    work(0);
+    for (std::thread &thread : threads) { thread.join(); }
+}
+
+
 void trim(std::string &str);
 
 
 std::mt19937 properly_seeded_random_engine();
 
 
+// Returns a new random engine seeded with values drawn from parent. Engines
+// split off in a fixed order from a deterministically seeded parent are
+// themselves deterministic, no matter which threads later use them.
+std::mt19937 split_random_engine(std::mt19937 &parent);
+
+
 std::string get_ymd_date(char sep);
 
 
@@ -0,0 +1,87 @@
+#ifndef SUCKER_CHESS_ZOBRIST_HPP
+#define SUCKER_CHESS_ZOBRIST_HPP
+
+#include <array>   // for std::array
+#include <cstddef> // for std::size_t
+#include <cstdint> // for std::uint64_t, std::uint8_t
+
+#include "Bitboard.hpp"
+#include "CastlingRights.hpp"
+#include "ChessMove.hpp"
+#include "ChessPiece.hpp"
+
+
+// A Zobrist hash key is the XOR of one pseudorandom key for each feature of
+// a position (each piece on each square, each castling right, the en passant
+// file, and the side to move). Making a move toggles only the features that
+// change, so the key can be updated incrementally in constant time.
+
+
+struct ZobristKeys {
+
+    // indexed by [6 * (PieceColor - 1) + (PieceType - 1)][square_index]
+    std::array<std::array<std::uint64_t, NUM_SQUARES>, 12> pieces;
+    std::array<std::uint64_t, 4> castling_rights;
+    std::array<std::uint64_t, NUM_FILES> en_passant_files;
+    std::uint64_t black_to_move;
+
+}; // struct ZobristKeys
+
+
+constexpr ZobristKeys ZOBRIST_KEYS = []() {
+    // SplitMix64 generator from:
+    // https://prng.di.unimi.it/splitmix64.c
+    std::uint64_t state = UINT64_C(0x5375636B65724368); // "SuckerCh"
+    const auto next = [&]() {
+        std::uint64_t z = (state += UINT64_C(0x9E3779B97F4A7C15));
+        z = (z ^ (z >> 30)) * UINT64_C(0xBF58476D1CE4E5B9);
+        z = (z ^ (z >> 27)) * UINT64_C(0x94D049BB133111EB);
+        return z ^ (z >> 31);
+    };
+    ZobristKeys result = {};
+    for (auto &piece_keys : result.pieces) {
+        for (auto &key : piece_keys) { key = next(); }
+    }
+    for (auto &key : result.castling_rights) { key = next(); }
+    for (auto &key : result.en_passant_files) { key = next(); }
+    result.black_to_move = next();
+    return result;
+}();
+
+
+[[nodiscard]] constexpr std::uint64_t
+zobrist_key(ChessPiece piece, ChessSquare square) noexcept {
+    if (piece == EMPTY_SQUARE) { return 0; }
+    const std::size_t piece_index =
+        6 * (static_cast<std::size_t>(piece.get_color()) - 1) +
+        (static_cast<std::size_t>(piece.get_type()) - 1);
+    return ZOBRIST_KEYS.pieces[piece_index][square_index(square)];
+}
+
+
+[[nodiscard]] constexpr std::uint64_t zobrist_key(CastlingRights rights
+) noexcept {
+    std::uint64_t result = 0;
+    if (rights.white_can_short_castle()) {
+        result ^= ZOBRIST_KEYS.castling_rights[0];
+    }
+    if (rights.white_can_long_castle()) {
+        result ^= ZOBRIST_KEYS.castling_rights[1];
+    }
+    if (rights.black_can_short_castle()) {
+        result ^= ZOBRIST_KEYS.castling_rights[2];
+    }
+    if (rights.black_can_long_castle()) {
+        result ^= ZOBRIST_KEYS.castling_rights[3];
+    }
+    return result;
+}
+
+
+[[nodiscard]] constexpr std::uint64_t zobrist_en_passant_key(coord_t file
+) noexcept {
+    return ZOBRIST_KEYS.en_passant_files[static_cast<std::size_t>(file)];
+}
+
+
+#endif // SUCKER_CHESS_ZOBRIST_HPP